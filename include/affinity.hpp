@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+// CPUs this process may run on, in ascending order. Honors cgroup/taskset restrictions,
+// which hardware_concurrency() does not.
+[[nodiscard]] inline std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set))
+                cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+
+    if (cpus.empty())
+        cpus.push_back(0);
+    return cpus;
+}
+
+// Pins the calling thread to a single CPU. Returns false if the kernel refused.
+inline bool pin_current_thread(int cpu) noexcept {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<std::size_t>(cpu), &set);
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+// Runs body(t) for every t in [0, thread_count) on its own thread, pinned round-robin over
+// `cpus`, and calls poll() from the calling thread every `interval` until the last body has
+// returned. Progress reporting and raising an abort flag on Ctrl+C belong in poll(); a body
+// that waits on a shared barrier must keep arriving after it bails out.
+template <typename Body, typename Poll>
+void run_pinned_workers(std::span<const int> cpus,
+                        std::size_t thread_count,
+                        Body&& body,
+                        Poll&& poll,
+                        std::chrono::milliseconds interval = std::chrono::milliseconds(50)) {
+    std::atomic<std::size_t> finished{0};
+    std::vector<std::jthread> workers;
+    workers.reserve(thread_count);
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&, t] {
+            pin_current_thread(cpus[t % cpus.size()]);
+            body(t);
+            finished.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    while (finished.load(std::memory_order_acquire) < thread_count) {
+        std::this_thread::sleep_for(interval);
+        poll();
+    }
+}
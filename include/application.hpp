@@ -7,13 +7,48 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "disk_benchmark.hpp"
+#include "noisy_neighbor.hpp"
+
+struct AppOptions {
+    bool cpu_benchmark = false;
+    int jitter_seconds = 0;  // 0 = jitter probe disabled
+    bool core_latency = false;
+    bool mem_bandwidth = false;
+    bool mem_latency = false;
+    bool disk_sweep = false;
+    bool disk_commit = false;
+    bool disk_all_mounts = false;
+    int metadata_files = 0;  // 0 = metadata test disabled
+    int small_files = 0;     // 0 = small-file test disabled
+    std::string raw_device;  // empty = raw device test disabled
+    std::string json_path;   // empty = no JSON output, "-" = NDJSON on stdout
+    std::optional<NoiseKind> disk_noise;  // re-run the disk tests under background load
+    double cold_ram_multiple = 0.0;  // 0 = cold-read test disabled
+    int disk_jobs = 0;  // 0 = multi-job test disabled
+    int steady_seconds = 0;  // 0 = steady-state test disabled
+    int steady_size_mb = Config::IO_STEADY_FILE_SIZE_MB;
+    std::vector<DiskEngine> disk_engines;  // empty = engine comparison disabled
+    DiskTestOptions disk;         // interrupt-driven runs; carries --compressible
+    DiskTestOptions polled_disk;  // --sqpoll / --iopoll
+
+    [[nodiscard]] bool wants_polled_disk() const {
+        return polled_disk.sqpoll || polled_disk.iopoll;
+    }
+};
 
 class Application {
    public:
     int run(int argc, char* argv[]);
 
    private:
+    AppOptions options_;
+
     void show_help(const std::string& app_name) const;
     void show_version() const;
 };
\ No newline at end of file
@@ -12,9 +12,31 @@
 #include <string>
 #include <string_view>
 #include <functional>
+#include <span>
+#include <utility>
 
 namespace CliRenderer {
 void render_speed_results(const SpeedTestResult& result);
+void render_cpu_results(const CpuBenchmarkResult& result, int label_width);
+void render_disk_random_results(const DiskRandomResult& result, int label_width);
+void render_noisy_neighbor_results(const DiskNoisyNeighborResult& result, int label_width);
+void render_kernel_io_table(std::span<const std::pair<std::string, DiskKernelStats>> rows);
+void render_steal_table(std::span<const std::pair<std::string, CpuStealStats>> rows);
+void render_cpu_jitter_results(const CpuJitterResult& result, int label_width);
+void render_core_latency_results(const CpuCoreLatencyResult& result, int label_width);
+void render_memory_bandwidth_results(const MemoryBandwidthResult& result, int label_width);
+void render_memory_latency_results(const MemoryLatencyResult& result, int label_width);
+void render_disk_sweep_results(const DiskSweepResult& result);
+void render_disk_multi_job_results(const DiskMultiJobResult& result, int label_width);
+void render_disk_cold_read_results(const DiskColdReadResult& result, int label_width);
+void render_disk_commit_results(const DiskCommitResult& result, int label_width);
+void render_disk_metadata_results(const DiskMetadataResult& result, int label_width);
+void render_disk_small_file_results(const DiskSmallFileResult& result, int label_width);
+void render_disk_raw_device_results(const DiskRawDeviceResult& result, int label_width);
+void render_disk_multi_path_results(const DiskMultiPathResult& result, int label_width);
+void render_disk_engine_results(const DiskEngineComparisonResult& result, int label_width);
+void render_disk_steady_state_results(const DiskSteadyStateResult& result, int label_width);
+void render_latency_table(std::span<const std::pair<std::string, LatencyStats>> rows);
 SpinnerCallback make_spinner_callback();
 
 std::string create_progress_bar(int percent);
@@ -7,7 +7,9 @@
  */
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace Config {
@@ -21,11 +23,132 @@ constexpr int IO_READ_QUEUE_DEPTH = 16;
 constexpr std::size_t IO_WRITE_BLOCK_SIZE = 1 * 1024 * 1024;
 constexpr std::size_t IO_READ_BLOCK_SIZE = 1 * 1024 * 1024;
 constexpr std::size_t IO_ALIGNMENT = 4096;
+constexpr int IO_PAYLOAD_COMPRESSIBLE_PERCENT = 0;
+
+constexpr int IO_RANDOM_FILE_SIZE_MB = 256;
+constexpr int IO_RANDOM_QUEUE_DEPTH = 32;
+constexpr std::size_t IO_RANDOM_BLOCK_SIZE = 4096;
+constexpr int IO_RANDOM_PHASE_SECONDS = 5;
+constexpr std::uint64_t IO_RANDOM_MAX_OPS = 1 << 20;
+constexpr int IO_RANDOM_MIXED_READ_PERCENT = 70;
+
+constexpr int IO_MULTI_JOB_FILE_SIZE_MB = 256;
+constexpr int IO_MULTI_JOB_QUEUE_DEPTH = 8;
+constexpr int IO_MULTI_JOB_MAX = 64;
+
+constexpr int IO_STEADY_DURATION_SECONDS = 60;
+constexpr int IO_STEADY_MAX_DURATION_SECONDS = 3600;
+constexpr int IO_STEADY_FILE_SIZE_MB = 4096;
+constexpr int IO_STEADY_SAMPLE_MS = 100;
+constexpr double IO_STEADY_CLIFF_RATIO = 0.8;
+
+constexpr int IO_ENGINE_FILE_SIZE_MB = 1024;
+
+constexpr int IO_MULTI_PATH_FILE_SIZE_MB = 1024;
+
+constexpr int IO_RAW_PHASE_SECONDS = 10;
+
+// Noisy-neighbor memory load is split across workers, each streaming its own buffer.
+constexpr std::size_t NOISY_MEMORY_TOTAL_MB = 1024;
+constexpr std::size_t NOISY_MEMORY_MIN_WORKER_MB = 32;
+
+constexpr double IO_CONVERGE_TOLERANCE = 0.05;  // 95% CI half-width as a fraction of the mean
+constexpr int IO_CONVERGE_SAMPLE_MS = 250;
+constexpr int IO_CONVERGE_MIN_SECONDS = 3;
+constexpr std::size_t IO_CONVERGE_MIN_SAMPLES = 12;
+
+constexpr double IO_COLD_RAM_MULTIPLE = 2.0;
+constexpr double IO_COLD_MAX_RAM_MULTIPLE = 16.0;
+constexpr int IO_COLD_MAX_SPACE_PERCENT = 80;
+constexpr int IO_COLD_MIN_WORKING_SET_MB = 1024;
+constexpr std::size_t IO_COLD_REGION_BYTES = 64 * 1024 * 1024;
+constexpr std::uint64_t IO_COLD_READ_BUDGET_BYTES = 4ULL * 1024 * 1024 * 1024;
+
+constexpr int IO_COMMIT_FILE_SIZE_MB = 64;
+constexpr int IO_COMMIT_PHASE_SECONDS = 5;
+constexpr std::array<std::size_t, 3> IO_COMMIT_RECORD_SIZES = {512, 4 * 1024, 16 * 1024};
+
+constexpr int IO_META_FILES = 20000;
+constexpr int IO_META_MAX_FILES = 1000000;
+constexpr int IO_META_DIRECTORIES = 64;
+constexpr int IO_META_MAX_THREADS = 8;
+constexpr int IO_META_QUEUE_DEPTH = 32;
+
+constexpr int IO_SMALL_FILES = 10000;
+constexpr int IO_SMALL_MAX_FILES = 1000000;
+constexpr int IO_SMALL_DIRECTORIES = 64;
+constexpr int IO_SMALL_MAX_THREADS = 8;
+constexpr int IO_SMALL_QUEUE_DEPTH = 16;  // open->io->close chains in flight per ring
+// Each file's size is drawn uniformly from this list; the largest sizes the buffer slots.
+constexpr std::array<std::size_t, 5> IO_SMALL_FILE_SIZES = {
+    4 * 1024, 8 * 1024, 16 * 1024, 32 * 1024, 64 * 1024};
+
+constexpr int IO_SWEEP_FILE_SIZE_MB = 1024;
+constexpr int IO_SWEEP_CELL_SECONDS = 2;
+// The sweep's buffer pool covers its largest cell (deepest queue x largest block), clamped
+// to this share of available memory; cells that still do not fit are skipped.
+constexpr std::size_t IO_SWEEP_MAX_MEMORY_PERCENT = 25;
+constexpr std::array<int, 9> IO_SWEEP_QUEUE_DEPTHS = {1, 2, 4, 8, 16, 32, 64, 128, 256};
+constexpr std::array<std::size_t, 6> IO_SWEEP_BLOCK_SIZES = {
+    4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024};
+
+// CPU kernels, in CpuKernel order: integer hash, branchy parse, FP matmul, zlib compression.
+// Every thread makes CPU_KERNEL_PASSES passes over its own copy of the input; scores are
+// rate / CPU_REFERENCE_RATES x 1000.
+// The reference rates (MiB/s, MiB/s, GFLOP/s, MiB/s) were measured single-threaded on one
+// vCPU of a KVM guest on a Xeon host, running the Release build: -march=x86-64-v3, with
+// cpu_benchmark.cpp at -O3 outside the unity batch. A build without those flags scores low
+// against them. The pass counts are sized so each kernel runs for about one second per
+// thread at the reference rate (e.g. 160000 x 64 KiB = 10000 MiB of hashing).
+constexpr std::size_t CPU_HASH_BYTES = 64 * 1024;
+constexpr std::size_t CPU_PARSE_BYTES = 64 * 1024;
+constexpr std::size_t CPU_MATMUL_N = 128;
+constexpr std::size_t CPU_COMPRESS_BYTES = 256 * 1024;
+constexpr int CPU_COMPRESS_LEVEL = 6;
+constexpr std::array<int, 4> CPU_KERNEL_PASSES = {160000, 5000, 3000, 60};
+constexpr std::array<double, 4> CPU_REFERENCE_RATES = {10000.0, 330.0, 12.0, 15.0};
+
+// Jitter probe: one pinned thread per CPU reads the clock back to back. A gap of at least
+// the first bucket edge means the thread was not running: an interrupt, another task or
+// the hypervisor. Buckets are lower edges; the last one is open-ended.
+constexpr int CPU_JITTER_SECONDS = 10;
+constexpr int CPU_JITTER_MAX_SECONDS = 600;
+constexpr std::array<double, 7> CPU_JITTER_BUCKETS_US = {10, 25, 50, 100, 500, 1000, 5000};
+constexpr double CPU_STEAL_WARN_PERCENT = 5.0;
+
+// Core-to-core latency: CPU_C2C_SAMPLES batches of CPU_C2C_ROUND_TRIPS cache-line ping-pongs
+// per pair, keeping the fastest batch. Domains split at the highest gap between sorted pair
+// latencies of at least CPU_C2C_DOMAIN_GAP_RATIO, i.e. at the coarsest topology boundary.
+constexpr int CPU_C2C_ROUND_TRIPS = 10000;
+constexpr int CPU_C2C_SAMPLES = 5;
+constexpr double CPU_C2C_DOMAIN_GAP_RATIO = 1.3;
+
+// STREAM arrays are four times the largest cache so no kernel can run from it, clamped to
+// the range below and to MEM_STREAM_MAX_MEMORY_PERCENT of available memory for all three.
+constexpr int MEM_STREAM_REPS = 5;
+constexpr std::size_t MEM_STREAM_MIN_ARRAY_BYTES = 64ULL * 1024 * 1024;
+constexpr std::size_t MEM_STREAM_MAX_ARRAY_BYTES = 1024ULL * 1024 * 1024;
+constexpr std::size_t MEM_STREAM_MAX_MEMORY_PERCENT = 50;
+constexpr double MEM_STREAM_SCALAR = 3.0;
+
+// Pointer-chase latency sweep over power-of-two working sets, capped to
+// MEM_LATENCY_MAX_MEMORY_PERCENT of available memory. A run of steps each rising more
+// than MEM_LATENCY_STEP_RATIO is one transition; it marks a new level when the whole run
+// rises by MEM_LATENCY_KNEE_RATIO or more.
+constexpr std::size_t MEM_LATENCY_MIN_BYTES = 4 * 1024;
+constexpr std::size_t MEM_LATENCY_MAX_BYTES = 1024ULL * 1024 * 1024;
+constexpr std::size_t MEM_LATENCY_MAX_MEMORY_PERCENT = 50;
+constexpr std::size_t MEM_LATENCY_ACCESSES = 4 * 1024 * 1024;
+constexpr double MEM_LATENCY_STEP_RATIO = 1.15;
+constexpr double MEM_LATENCY_KNEE_RATIO = 1.5;
+
 constexpr std::size_t TERM_WIDTH = 80;
 constexpr std::size_t MAX_ERROR_DISPLAY_LEN = 45;
 constexpr std::string_view TEST_FILENAME = "calyx_test_file";
 
 constexpr bool IO_URING_ENABLED = true;
+constexpr bool IO_URING_REGISTER_RESOURCES = true;
+constexpr unsigned IO_SQPOLL_IDLE_MS = 2000;
 constexpr std::size_t PIPE_MAX_OUTPUT_BYTES = 10 * 1024 * 1024;
 constexpr std::string_view SPEEDTEST_CLI_PATH = "speedtest-cli/speedtest";
 constexpr std::string_view SPEEDTEST_TGZ = "speedtest.tgz";
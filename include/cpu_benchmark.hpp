@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+#include "results.hpp"
+#include "system_info.hpp"
+
+// Fixed-work compute kernels. Inputs come from a fixed seed, so every machine does the
+// same work and the rates compare directly.
+enum class CpuKernel { IntegerHash, BranchyParse, FloatMatmul, Compression };
+
+class CpuBenchmark {
+   public:
+    static constexpr std::array<CpuKernel, 4> ALL_KERNELS = {CpuKernel::IntegerHash,
+                                                             CpuKernel::BranchyParse,
+                                                             CpuKernel::FloatMatmul,
+                                                             CpuKernel::Compression};
+
+    [[nodiscard]] static std::string_view kernel_name(CpuKernel kernel) noexcept;
+    [[nodiscard]] static std::string_view kernel_unit(CpuKernel kernel) noexcept;
+
+    // Runs each kernel's Config::CPU_KERNEL_PASSES on one pinned thread, then the same
+    // passes on every allowed CPU at once (one pinned thread each), and scores both
+    // against Config::CPU_REFERENCE_RATES.
+    static std::expected<CpuBenchmarkResult, std::string> run(
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Spins one pinned thread per allowed CPU for `seconds`, each reading steady_clock
+    // back to back and histogramming the gaps above Config::CPU_JITTER_BUCKETS_US[0],
+    // alongside each CPU's steal share over the same window.
+    static std::expected<CpuJitterResult, std::string> run_jitter_probe(
+        int seconds,
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Pins a thread to each pair of allowed CPUs in turn and bounces one cache line between
+    // them through an atomic counter, then groups the CPUs into latency domains.
+    static std::expected<CpuCoreLatencyResult, std::string> run_core_latency(
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    [[nodiscard]] static CpuStealStats steal_between(const CpuTimes& before,
+                                                     const CpuTimes& after) noexcept;
+};
@@ -7,20 +7,135 @@
  */
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <expected>
 #include <functional>
+#include <optional>
+#include <span>
 #include <stop_token>
 #include <string>
 #include <string_view>
 
+#include "config.hpp"
 #include "results.hpp"
+#include "system_info.hpp"
+
+struct DiskTestOptions {
+    bool sqpoll = false;
+    int sqpoll_cpu = -1;  // -1 leaves the SQ thread unpinned
+    bool iopoll = false;
+    int compressible_percent = Config::IO_PAYLOAD_COMPRESSIBLE_PERCENT;
+    bool verify = false;    // run_io_test: add a read pass that checks every sector
+    std::string directory;  // run_io_test: where the test file goes; empty = current dir
+    // run_io_test: > 0 ends each phase early once the 95% CI of its throughput is within
+    // this fraction of the mean (after Config::IO_CONVERGE_MIN_SECONDS).
+    double converge_tolerance = 0.0;
+};
+
+// Ways of moving the same bytes to and from the test file. Only IoUringDirect bypasses
+// the page cache; the others show what applications that do not use O_DIRECT see.
+enum class DiskEngine { IoUringDirect, IoUringBuffered, Psync, Mmap };
 
 class DiskBenchmark {
    public:
+    static constexpr std::array<DiskEngine, 4> ALL_ENGINES = {DiskEngine::IoUringDirect,
+                                                              DiskEngine::IoUringBuffered,
+                                                              DiskEngine::Psync,
+                                                              DiskEngine::Mmap};
+
+    [[nodiscard]] static std::string_view engine_name(DiskEngine engine) noexcept;
+    [[nodiscard]] static std::optional<DiskEngine> parse_engine(std::string_view name) noexcept;
+
     static std::expected<DiskIORunResult, std::string> run_io_test(
         int size_mb,
         std::string_view label,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    static std::expected<DiskRandomResult, std::string> run_random_test(
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    static std::expected<DiskMultiJobResult, std::string> run_multi_job_test(
+        int jobs,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Writes, then reads, laps of a file_size_mb file for duration_s each, sampling
+    // throughput every Config::IO_STEADY_SAMPLE_MS to expose SLC-cache or burst-credit
+    // cliffs that a fixed-size run finishes before reaching.
+    static std::expected<DiskSteadyStateResult, std::string> run_steady_state_test(
+        int duration_s,
+        int file_size_mb,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Writes and then cold-reads one Config::IO_ENGINE_FILE_SIZE_MB file with each engine
+    // in turn, flushing and dropping the page cache between phases.
+    static std::expected<DiskEngineComparisonResult, std::string> run_engine_comparison(
+        std::span<const DiskEngine> engines,
+        int compressible_percent = Config::IO_PAYLOAD_COMPRESSIBLE_PERCENT,
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Appends small records and makes each one durable before the next, once with
+    // pwrite + fdatasync and once with an io_uring WRITE linked to a datasync FSYNC.
+    static std::expected<DiskCommitResult, std::string> run_commit_test(
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Writes a working set of ram_multiple x total RAM, then reads a budget of regions from
+    // its oldest part in shuffled order (cold) and reads the same regions again (warm).
+    // The gap between the two is what host-side caches below the guest were adding.
+    static std::expected<DiskColdReadResult, std::string> run_cold_read_test(
+        double ram_multiple,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Reads a block device node (e.g. /dev/nvme0n1) directly: sequentially, then at random,
+    // sized and aligned to the queue limits in sysfs. The device is opened O_RDONLY and is
+    // never written.
+    static std::expected<DiskRawDeviceResult, std::string> run_raw_device_test(
+        const std::string& device,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Runs run_io_test on each mount. Mounts whose backing disks overlap form a group and run
+    // one after another; separate groups run at the same time, one thread each.
+    static std::expected<DiskMultiPathResult, std::string> run_multi_path_test(
+        std::span<const MountEntry> mounts,
+        int size_mb,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Creates, stats, renames and unlinks `files` empty files spread over
+    // Config::IO_META_DIRECTORIES directories, split across threads that start each phase
+    // together. Uses io_uring OPENAT/CLOSE/STATX/RENAMEAT/UNLINKAT when the kernel has all
+    // of them, plain syscalls otherwise.
+    static std::expected<DiskMetadataResult, std::string> run_metadata_test(
+        int files,
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Writes `files` files of 4K-64K (Config::IO_SMALL_FILE_SIZES), syncs the filesystem,
+    // evicts them from the page cache and reads them back, one io_uring per thread running
+    // linked open -> write/read -> close chains. Write time includes the syncfs.
+    static std::expected<DiskSmallFileResult, std::string> run_small_file_test(
+        int files,
+        const DiskTestOptions& options = {},
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    static std::expected<DiskSweepResult, std::string> run_sweep_test(
+        const DiskTestOptions& options = {},
         const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
         std::stop_token stop = {});
 };
\ No newline at end of file
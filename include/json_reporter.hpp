@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "file_descriptor.hpp"
+#include "results.hpp"
+#include "system_info.hpp"
+
+// nlohmann::json serializers for the result structs, found by ADL so that
+// `nlohmann::json j = result;` works wherever this header is included.
+void to_json(nlohmann::json& j, const LatencyStats& stats);
+void to_json(nlohmann::json& j, const DiskKernelStats& stats);
+void to_json(nlohmann::json& j, const DiskIORunResult& result);
+void to_json(nlohmann::json& j, const DiskRandomPhaseResult& phase);
+void to_json(nlohmann::json& j, const DiskRandomResult& result);
+void to_json(nlohmann::json& j, const DiskNoisyPhaseChange& change);
+void to_json(nlohmann::json& j, const DiskNoisyNeighborResult& result);
+void to_json(nlohmann::json& j, const DiskRawDeviceResult& result);
+void to_json(nlohmann::json& j, const DiskSweepCell& cell);
+void to_json(nlohmann::json& j, const DiskSweepResult& result);
+void to_json(nlohmann::json& j, const DiskJobResult& job);
+void to_json(nlohmann::json& j, const DiskMultiJobResult& result);
+void to_json(nlohmann::json& j, const DiskSteadyStatePhaseResult& phase);
+void to_json(nlohmann::json& j, const DiskSteadyStateResult& result);
+void to_json(nlohmann::json& j, const DiskEngineResult& engine);
+void to_json(nlohmann::json& j, const DiskEngineComparisonResult& result);
+void to_json(nlohmann::json& j, const DiskCommitPhaseResult& phase);
+void to_json(nlohmann::json& j, const DiskCommitResult& result);
+void to_json(nlohmann::json& j, const DiskColdReadResult& result);
+void to_json(nlohmann::json& j, const DiskPathResult& path);
+void to_json(nlohmann::json& j, const DiskMultiPathResult& result);
+void to_json(nlohmann::json& j, const DiskMetadataPhaseResult& phase);
+void to_json(nlohmann::json& j, const DiskMetadataResult& result);
+void to_json(nlohmann::json& j, const DiskSmallFilePhaseResult& phase);
+void to_json(nlohmann::json& j, const DiskSmallFileResult& result);
+void to_json(nlohmann::json& j, const CpuKernelResult& kernel);
+void to_json(nlohmann::json& j, const CpuBenchmarkResult& result);
+void to_json(nlohmann::json& j, const CpuStealStats& stats);
+void to_json(nlohmann::json& j, const CpuJitterCoreResult& core);
+void to_json(nlohmann::json& j, const CpuJitterResult& result);
+void to_json(nlohmann::json& j, const CpuLatencyDomain& domain);
+void to_json(nlohmann::json& j, const CpuCoreLatencyResult& result);
+void to_json(nlohmann::json& j, const MemoryBandwidthKernelResult& kernel);
+void to_json(nlohmann::json& j, const MemoryBandwidthResult& result);
+void to_json(nlohmann::json& j, const MemoryLatencyPoint& point);
+void to_json(nlohmann::json& j, const MemoryLatencyLevel& level);
+void to_json(nlohmann::json& j, const MemoryLatencyResult& result);
+void to_json(nlohmann::json& j, const SpeedEntryResult& entry);
+void to_json(nlohmann::json& j, const SwapEntry& swap);
+void to_json(nlohmann::json& j, const MemInfo& mem);
+void to_json(nlohmann::json& j, const DiskInfo& disk);
+
+// Streams results as NDJSON: one {"run", "seq", "type", "data"} object per line, written
+// with a single write(2) as soon as a benchmark finishes, so an interrupted run still
+// leaves every completed record behind. "run" ties the lines of one invocation together
+// when many runs are appended to the same file.
+class JsonReporter {
+    FileDescriptor fd_;
+    std::string run_id_;
+    std::uint64_t seq_ = 0;
+
+    explicit JsonReporter(FileDescriptor fd);
+
+   public:
+    // Opens `path` for append, creating it if needed.
+    static std::expected<JsonReporter, std::string> open(const std::string& path);
+    // Takes over an already open descriptor, e.g. a dup of the original stdout.
+    static JsonReporter adopt(FileDescriptor fd);
+
+    void emit(std::string_view type, const nlohmann::json& data);
+    void emit_error(std::string_view benchmark, std::string_view message);
+};
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "results.hpp"
+
+// Log-linear (HDR-style) histogram of nanosecond latencies. Each power of two is split
+// into SUB_BUCKETS linear steps, which bounds the relative error to 1/SUB_BUCKETS across
+// the whole 64-bit range. Storage is a fixed array of relaxed atomics, so record() never
+// allocates or locks and can be called from several completion threads at once.
+class LatencyHistogram {
+   public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr std::uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(std::uint64_t value_ns) noexcept {
+        buckets_[bucket_index(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value_ns, std::memory_order_relaxed);
+
+        std::uint64_t seen = min_.load(std::memory_order_relaxed);
+        while (value_ns < seen &&
+               !min_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed)) {
+        }
+        seen = max_.load(std::memory_order_relaxed);
+        while (value_ns > seen &&
+               !max_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    // Value (ns) at or below which `pct` percent of the recorded samples fall.
+    [[nodiscard]] std::uint64_t value_at_percentile(double pct) const noexcept;
+
+    [[nodiscard]] LatencyStats summarize() const noexcept;
+
+    [[nodiscard]] static constexpr std::size_t bucket_index(std::uint64_t value) noexcept {
+        if (value < 2 * SUB_BUCKETS)
+            return static_cast<std::size_t>(value);
+
+        const auto shift = static_cast<unsigned>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+        return static_cast<std::size_t>(shift * SUB_BUCKETS + (value >> shift));
+    }
+
+    // Midpoint of the value range covered by a bucket.
+    [[nodiscard]] static constexpr std::uint64_t bucket_value(std::size_t index) noexcept {
+        if (index < 2 * SUB_BUCKETS)
+            return index;
+
+        const auto shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+        const std::uint64_t lower = (index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+        return lower + ((1ULL << shift) >> 1);
+    }
+
+   private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+static_assert(LatencyHistogram::bucket_index(std::numeric_limits<std::uint64_t>::max()) <
+                  LatencyHistogram::BUCKET_COUNT,
+              "Histogram bucket table too small for 64-bit values");
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+#include "results.hpp"
+
+// The four STREAM kernels over double arrays a, b, c with scalar q:
+// copy c = a, scale b = q*c, add c = a + b, triad a = b + q*c.
+enum class StreamKernel { Copy, Scale, Add, Triad };
+
+class MemoryBenchmark {
+   public:
+    static constexpr std::array<StreamKernel, 4> ALL_KERNELS = {
+        StreamKernel::Copy, StreamKernel::Scale, StreamKernel::Add, StreamKernel::Triad};
+
+    [[nodiscard]] static std::string_view kernel_name(StreamKernel kernel) noexcept;
+
+    // Sizes three arrays well past the largest CPU cache, then runs every kernel
+    // Config::MEM_STREAM_REPS times on one pinned thread and again on every allowed CPU,
+    // keeping the best rep of each as STREAM does.
+    static std::expected<MemoryBandwidthResult, std::string> run_bandwidth_test(
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // Walks a random cycle through every cache line of each working set from
+    // Config::MEM_LATENCY_MIN_BYTES to MEM_LATENCY_MAX_BYTES on one pinned thread, once
+    // with huge pages and once with MADV_NOHUGEPAGE, and names the plateaus of the
+    // huge-page curve L1, L2, ... DRAM.
+    static std::expected<MemoryLatencyResult, std::string> run_latency_sweep(
+        const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb = {},
+        std::stop_token stop = {});
+
+    // The bracketed choice in /sys/kernel/mm/transparent_hugepage/enabled, or "unknown".
+    [[nodiscard]] static std::string transparent_hugepage_mode();
+};
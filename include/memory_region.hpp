@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <format>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+
+#include <sys/mman.h>
+
+struct AlignedDelete {
+    std::size_t alignment;
+
+    void operator()(void* ptr) const noexcept {
+        ::operator delete(ptr, std::align_val_t(alignment));
+    }
+};
+
+using AlignedBuffer = std::unique_ptr<std::byte[], AlignedDelete>;
+
+[[nodiscard]] inline std::expected<AlignedBuffer, std::string> make_aligned_buffer(
+    std::size_t size, std::size_t alignment) {
+    void* ptr = ::operator new(size, std::align_val_t(alignment), std::nothrow);
+
+    if (!ptr) [[unlikely]] {
+        return std::unexpected(
+            std::format("FATAL: Failed to allocate {} bytes (aligned to {}). System Out of Memory.",
+                        size,
+                        alignment));
+    }
+
+    return AlignedBuffer(static_cast<std::byte*>(ptr), AlignedDelete{alignment});
+}
+
+// Asks for transparent huge pages on a buffer before it is first touched. Only takes
+// effect on 2 MiB-aligned ranges and when THP is not disabled system-wide.
+inline void optimize_memory_region(std::span<std::byte> mem) noexcept {
+    if (mem.empty())
+        return;
+
+    void* ptr = mem.data();
+    size_t size = mem.size_bytes();
+
+    ::madvise(ptr, size, MADV_HUGEPAGE);
+}
+
+// The opposite, for measurements that need 4 KiB pages even when THP is "always".
+inline void use_small_pages(std::span<std::byte> mem) noexcept {
+    if (mem.empty())
+        return;
+
+    ::madvise(mem.data(), mem.size_bytes(), MADV_NOHUGEPAGE);
+}
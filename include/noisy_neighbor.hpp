@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+enum class NoiseKind { Cpu, Memory };
+
+// Background load for measuring how the disk holds up on a busy node. While alive, one
+// pinned worker per allowed CPU except the first either spins on ALU work or streams
+// read-modify-writes through a buffer larger than the LLC. The constructing thread, which
+// runs the benchmark's submit/complete loop, is pinned to that first CPU until the object
+// is destroyed; on a single-CPU box the worker shares it.
+// Workers stop and join, and the thread's affinity is restored, on destruction.
+class NoisyNeighbor {
+   public:
+    explicit NoisyNeighbor(NoiseKind kind);
+    ~NoisyNeighbor();
+
+    NoisyNeighbor(const NoisyNeighbor&) = delete;
+    NoisyNeighbor& operator=(const NoisyNeighbor&) = delete;
+
+    [[nodiscard]] std::size_t workers() const noexcept {
+        return workers_.size();
+    }
+
+    [[nodiscard]] static std::string_view kind_name(NoiseKind kind) noexcept;
+    [[nodiscard]] static std::optional<NoiseKind> parse_kind(std::string_view name) noexcept;
+
+   private:
+    std::vector<std::jthread> workers_;
+    cpu_set_t saved_affinity_{};
+    bool restore_affinity_ = false;
+};
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+
+// Produces write payloads that compressing or deduplicating storage cannot shortcut.
+// Every 4 KiB sector starts with a stamp of its file offset, the generator's run seed and
+// a caller-supplied sequence number, followed by xoshiro256++ output seeded from those,
+// so no two sectors match within or across runs. The final `compressible_percent` of
+// each sector is zeroed to model data that compresses by roughly that ratio.
+//
+// Because the content is a pure function of (seed, offset, sequence), verify() can
+// regenerate it and compare in place: no checksum has to be stored or computed on the
+// write path, and the check catches every flipped bit rather than most.
+class PayloadGenerator {
+   public:
+    static constexpr std::size_t SECTOR_SIZE = 4096;
+
+    explicit PayloadGenerator(int compressible_percent);
+
+    void fill(std::span<std::byte> block,
+              std::uint64_t offset,
+              std::uint64_t sequence = 0) const noexcept;
+
+    // Checks a block read back from `offset`. The error names the first bad sector and
+    // whether it held another offset's data, another run's, an older write, or garbage.
+    [[nodiscard]] std::expected<void, std::string> verify(std::span<const std::byte> block,
+                                                          std::uint64_t offset,
+                                                          std::uint64_t sequence = 0) const;
+
+    [[nodiscard]] int compressible_percent() const noexcept {
+        return compressible_percent_;
+    }
+
+   private:
+    std::uint64_t seed_;
+    int compressible_percent_;
+    std::size_t random_bytes_;  // per sector, stamp included
+};
@@ -7,13 +7,228 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
+struct LatencyStats {
+    std::uint64_t samples = 0;
+    double min_us = 0.0;
+    double mean_us = 0.0;
+    double p50_us = 0.0;
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+    double p999_us = 0.0;
+    double max_us = 0.0;
+};
+
+// What the block layer saw during one phase, from diskstats deltas. A kernel request
+// size below the submitted one means requests were split (max_sectors_kb or the
+// hypervisor); merges or a larger size mean they were coalesced.
+struct DiskKernelStats {
+    std::string device;
+    double iops = 0.0;
+    double merge_percent = 0.0;  // merged / (completed + merged)
+    double request_kib = 0.0;    // average kernel-observed request size
+    double submitted_kib = 0.0;  // what the benchmark issued
+    double avg_queue = 0.0;      // mean in-flight requests (iostat aqu-sz)
+    double util_percent = 0.0;
+};
+
 struct DiskIORunResult {
     std::string label;
     double write_mbps = 0.0;
     double read_mbps = 0.0;
+    LatencyStats write_latency;
+    LatencyStats read_latency;
+    bool verified = false;  // read back a second time with every sector checked
+    double verify_read_mbps = 0.0;
+    bool converged = false;          // a phase stopped early on its confidence interval
+    std::uint64_t bytes_written = 0;  // less than the requested size when converged
+    // 95% CI half-width of interval throughput; unset when too few intervals closed to say.
+    std::optional<double> write_ci_mbps;
+    std::optional<double> read_ci_mbps;
+    std::optional<DiskKernelStats> write_kernel;
+    std::optional<DiskKernelStats> read_kernel;
+    std::string io_path;
+};
+
+struct DiskRandomPhaseResult {
+    std::string label;
+    double iops = 0.0;
+    double mbps = 0.0;
+    LatencyStats latency;
+};
+
+struct DiskRandomResult {
+    std::vector<DiskRandomPhaseResult> phases;
+    int queue_depth = 0;
+    std::size_t block_size = 0;
+    std::string io_path;
+};
+
+// One random phase's change under load, matched to its idle phase by label.
+struct DiskNoisyPhaseChange {
+    std::string label;
+    double iops_percent = 0.0;  // vs the idle phase with the same label
+    double p99_percent = 0.0;
+};
+
+// The sequential and random tests re-run under NoisyNeighbor load, with their change
+// against the idle runs of the same invocation.
+struct DiskNoisyNeighborResult {
+    std::string load;  // "cpu" or "memory"
+    std::size_t workers = 0;
+    DiskIORunResult run;
+    double write_percent = 0.0;  // vs the idle runs' average
+    double read_percent = 0.0;
+    std::optional<DiskRandomResult> random;           // unset when the loaded run failed
+    std::vector<DiskNoisyPhaseChange> random_changes;  // empty without an idle random run
+};
+
+// Read-only run against a block device node; phases are sequential then random read.
+struct DiskRawDeviceResult {
+    std::string device;
+    std::uint64_t size = 0;
+    std::size_t logical_block_size = 0;
+    std::size_t max_io_bytes = 0;  // queue/max_sectors_kb
+    std::vector<DiskRandomPhaseResult> phases;
+    std::string io_path;
+};
+
+struct DiskSweepCell {
+    int queue_depth = 0;
+    std::size_t block_size = 0;
+    double iops = 0.0;
+    double mbps = 0.0;
+    LatencyStats latency;
+    bool skipped = false;
+};
+
+struct DiskSweepResult {
+    std::vector<int> queue_depths;
+    std::vector<std::size_t> block_sizes;
+    std::vector<DiskSweepCell> cells;  // row-major: one row per block size
+    std::size_t pool_bytes = 0;        // buffer pool every cell's in-flight I/O came from
+    std::string io_path;
+};
+
+struct DiskJobResult {
+    int cpu = -1;
+    double write_mbps = 0.0;
+    double read_mbps = 0.0;
+};
+
+struct DiskMultiJobResult {
+    std::vector<DiskJobResult> jobs;
+    double aggregate_write_mbps = 0.0;
+    double aggregate_read_mbps = 0.0;
+    double write_fairness = 0.0;  // Jain's index, 1.0 = perfectly even
+    double read_fairness = 0.0;
+    std::string io_path;
+};
+
+struct DiskSteadyStatePhaseResult {
+    std::string label;
+    std::vector<double> series_mbps;  // one sample per sample_interval_ms
+    int sample_interval_ms = 0;
+    double mean_mbps = 0.0;
+    double burst_mbps = 0.0;
+    double steady_mbps = 0.0;
+    double cliff_seconds = -1.0;  // -1 when throughput held up for the whole phase
+};
+
+struct DiskSteadyStateResult {
+    std::vector<DiskSteadyStatePhaseResult> phases;
+    std::uint64_t file_size = 0;
+    int duration_seconds = 0;
+    std::string io_path;
+};
+
+struct DiskEngineResult {
+    std::string engine;
+    double write_mbps = 0.0;
+    double read_mbps = 0.0;
+    std::string io_path;
+};
+
+struct DiskEngineComparisonResult {
+    std::vector<DiskEngineResult> engines;
+    std::uint64_t file_size = 0;
+};
+
+struct DiskCommitPhaseResult {
+    std::string method;
+    std::size_t record_size = 0;
+    double commits_per_sec = 0.0;
+    LatencyStats latency;
+};
+
+struct DiskCommitResult {
+    std::vector<DiskCommitPhaseResult> phases;
+};
+
+struct DiskColdReadResult {
+    std::uint64_t working_set = 0;
+    std::uint64_t ram_total = 0;
+    std::uint64_t bytes_read = 0;  // per pass
+    std::size_t regions = 0;
+    double cold_mbps = 0.0;
+    double warm_mbps = 0.0;
+    LatencyStats cold_latency;
+    LatencyStats warm_latency;
+    bool space_limited = false;  // working set was capped by free space below the target
+    std::string io_path;
+};
+
+struct DiskPathResult {
+    std::string mount_point;
+    std::string source;
+    std::string fs_type;
+    std::string disks;  // backing disks, "+"-joined
+    int group = 0;      // mounts in one group share a disk and ran back to back
+    double write_mbps = 0.0;
+    double read_mbps = 0.0;
+    std::string io_path;
+    std::string error;  // set when this mount was skipped or failed
+};
+
+struct DiskMultiPathResult {
+    std::vector<DiskPathResult> paths;
+    std::uint64_t file_size = 0;
+    int groups = 0;
+};
+
+struct DiskMetadataPhaseResult {
+    std::string op;  // Create, Stat, Rename, Unlink
+    std::uint64_t ops = 0;
+    double ops_per_sec = 0.0;
+};
+
+struct DiskMetadataResult {
+    std::vector<DiskMetadataPhaseResult> phases;
+    std::uint64_t files = 0;
+    int directories = 0;
+    int threads = 0;
+    std::string filesystem;  // as SystemInfo::get_device_name reports it
+    std::string io_path;
+};
+
+struct DiskSmallFilePhaseResult {
+    std::string op;  // Write, Read
+    double files_per_sec = 0.0;
+    double mbps = 0.0;
+};
+
+struct DiskSmallFileResult {
+    std::vector<DiskSmallFilePhaseResult> phases;
+    std::uint64_t files = 0;
+    std::uint64_t total_bytes = 0;
+    int threads = 0;
+    std::string filesystem;
+    std::string io_path;
 };
 
 struct DiskSuiteResult {
@@ -22,6 +237,98 @@ struct DiskSuiteResult {
     double average_read_mbps = 0.0;
 };
 
+struct CpuKernelResult {
+    std::string name;
+    std::string unit;  // MB/s or GFLOPS
+    double single_rate = 0.0;
+    double multi_rate = 0.0;
+    double single_score = 0.0;        // 1000 = Config::CPU_REFERENCE_RATES
+    double multi_score = 0.0;
+    double scaling_efficiency = 0.0;  // multi_rate / (single_rate x threads)
+};
+
+struct CpuBenchmarkResult {
+    std::vector<CpuKernelResult> kernels;
+    int threads = 0;
+    double single_score = 0.0;  // geometric mean of the kernel scores
+    double multi_score = 0.0;
+    double scaling_efficiency = 0.0;
+};
+
+// Share of CPU time over an interval, from /proc/stat deltas. Steal is time the
+// hypervisor gave the physical core to another guest while this vCPU wanted to run.
+struct CpuStealStats {
+    double steal_percent = 0.0;
+    double iowait_percent = 0.0;
+};
+
+struct CpuJitterCoreResult {
+    int cpu = -1;
+    std::uint64_t gaps = 0;  // clock gaps at or above the threshold
+    double max_gap_us = 0.0;
+    double lost_percent = 0.0;  // summed gaps as a share of the probe time
+    double steal_percent = 0.0;
+    std::vector<std::uint64_t> histogram;  // one count per Config::CPU_JITTER_BUCKETS_US edge
+};
+
+struct CpuJitterResult {
+    std::vector<CpuJitterCoreResult> cores;
+    std::vector<double> bucket_edges_us;  // lower edge of each histogram bucket
+    int duration_seconds = 0;
+};
+
+// CPUs joined by pairs at or below the domain threshold, e.g. one CCD or one socket.
+struct CpuLatencyDomain {
+    std::vector<int> cpus;
+    double mean_round_trip_ns = 0.0;  // over the pairs inside the domain, 0 for one CPU
+};
+
+struct CpuCoreLatencyResult {
+    std::vector<int> cpus;
+    std::vector<std::vector<double>> round_trip_ns;  // [i][j] for cpus[i], cpus[j]; 0 diagonal
+    std::vector<CpuLatencyDomain> domains;
+    double domain_threshold_ns = 0.0;
+    double inter_domain_ns = 0.0;  // mean over pairs in different domains, 0 if only one
+};
+
+// STREAM bandwidth in GB/s (1e9 bytes), counting the bytes the kernel names: two arrays
+// for copy and scale, three for add and triad.
+struct MemoryBandwidthKernelResult {
+    std::string name;
+    double single_gbps = 0.0;
+    double multi_gbps = 0.0;
+};
+
+struct MemoryBandwidthResult {
+    std::vector<MemoryBandwidthKernelResult> kernels;
+    std::uint64_t array_bytes = 0;  // per array; three are live at once
+    int threads = 0;
+    std::string thp_mode;
+};
+
+// Average time of one dependent load at a working-set size, walking a random cycle over
+// its cache lines on 2 MiB pages (where THP allows) and on 4 KiB pages.
+struct MemoryLatencyPoint {
+    std::uint64_t size_bytes = 0;
+    double huge_page_ns = 0.0;
+    double small_page_ns = 0.0;
+};
+
+// A plateau of the huge-page curve: the largest size still on it and its latency.
+struct MemoryLatencyLevel {
+    std::string name;                  // L1, L2, ... and DRAM for the last plateau
+    std::uint64_t size_bytes = 0;
+    double latency_ns = 0.0;
+    std::uint64_t reported_bytes = 0;  // sysfs size of the same cache level, 0 if none
+};
+
+struct MemoryLatencyResult {
+    std::vector<MemoryLatencyPoint> points;
+    std::vector<MemoryLatencyLevel> levels;
+    int cpu = 0;
+    std::string thp_mode;
+};
+
 struct SpeedEntryResult {
     std::string server_id;
     std::string node_name;
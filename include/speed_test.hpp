@@ -18,6 +18,8 @@
 
 enum class SpinnerEvent { Start, Stop };
 using SpinnerCallback = std::function<void(SpinnerEvent, std::string_view)>;
+// Called as soon as each node finishes, before run() returns.
+using SpeedEntryCallback = std::function<void(const SpeedEntryResult&)>;
 
 class SpeedTest {
     HttpClient& http_;
@@ -33,5 +35,6 @@ class SpeedTest {
     ~SpeedTest();
 
     void install();
-    SpeedTestResult run(const SpinnerCallback& spinner_cb = {});
+    SpeedTestResult run(const SpinnerCallback& spinner_cb = {},
+                        const SpeedEntryCallback& entry_cb = {});
 };
\ No newline at end of file
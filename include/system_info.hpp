@@ -8,6 +8,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,56 @@ struct MemInfo {
     uint64_t available;
 };
 
+struct MountEntry {
+    std::string mount_point;
+    std::string source;  // /dev/nvme0n1p2, /dev/mapper/vg-data
+    std::string fs_type;
+    std::string major_minor;
+    std::vector<std::string> disks;  // whole disks underneath, e.g. {"nvme0n1"}
+};
+
+// Cumulative counters from /sys/class/block/<dev>/stat (or /proc/diskstats). Sectors are
+// always 512 bytes; *_ticks_ms are summed per-request wait times.
+struct DiskStatSnapshot {
+    std::uint64_t reads = 0;
+    std::uint64_t reads_merged = 0;
+    std::uint64_t sectors_read = 0;
+    std::uint64_t read_ticks_ms = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t writes_merged = 0;
+    std::uint64_t sectors_written = 0;
+    std::uint64_t write_ticks_ms = 0;
+    std::uint64_t in_flight = 0;
+    std::uint64_t io_ticks_ms = 0;     // time the device had at least one request in flight
+    std::uint64_t queue_ticks_ms = 0;  // in-flight count integrated over time
+};
+
+// One cpu line of /proc/stat, in USER_HZ ticks. cpu is -1 for the aggregate "cpu" line.
+// Guest time is already included in user, so it is not read separately.
+struct CpuTimes {
+    int cpu = -1;
+    std::uint64_t user = 0;
+    std::uint64_t nice = 0;
+    std::uint64_t system = 0;
+    std::uint64_t idle = 0;
+    std::uint64_t iowait = 0;
+    std::uint64_t irq = 0;
+    std::uint64_t softirq = 0;
+    std::uint64_t steal = 0;  // ticks the hypervisor ran something else while we were runnable
+
+    [[nodiscard]] std::uint64_t total() const noexcept {
+        return user + nice + system + idle + iowait + irq + softirq + steal;
+    }
+};
+
+// One cache of the requested CPU as sysfs reports it. Under a hypervisor these are whatever the
+// guest was told, which need not match the host.
+struct CpuCacheInfo {
+    int level = 0;
+    std::string type;  // Data, Instruction, Unified
+    std::uint64_t size = 0;
+};
+
 struct DiskInfo {
     uint64_t total;
     uint64_t used;
@@ -37,8 +88,11 @@ class SystemInfo {
     static std::string get_model_name();
     static std::string get_cpu_cores_freq();
     static std::string get_cpu_cache();
+    static std::vector<CpuCacheInfo> get_cpu_caches(int cpu = 0);
     static bool has_aes();
     static bool has_vmx();
+    // Aggregate line first, then one entry per online CPU.
+    static std::vector<CpuTimes> get_cpu_times();
     static std::string get_virtualization();
     static std::string get_os();
     static std::string get_arch();
@@ -53,4 +107,8 @@ class SystemInfo {
     static MemInfo get_memory_status();
     static DiskInfo get_disk_usage(const std::string& mountpoint);
     static std::string get_device_name(const std::string& path);
+    static std::vector<MountEntry> get_writable_mounts();
+    // Kernel name (e.g. "nvme0n1p2") of the block device backing `path`, if any.
+    static std::optional<std::string> get_block_device(const std::string& path);
+    static std::optional<DiskStatSnapshot> get_disk_stats(const std::string& device);
 };
\ No newline at end of file
@@ -7,23 +7,37 @@
  */
 #include "include/application.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <optional>
 #include <print>
+#include <ranges>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
 #include <nlohmann/json.hpp>
 
+#include "include/affinity.hpp"
 #include "include/cli_renderer.hpp"
 #include "include/color.hpp"
 #include "include/config.hpp"
+#include "include/cpu_benchmark.hpp"
 #include "include/disk_benchmark.hpp"
 #include "include/http_client.hpp"
 #include "include/http_context.hpp"
 #include "include/interrupts.hpp"
+#include "include/json_reporter.hpp"
+#include "include/memory_benchmark.hpp"
 #include "include/results.hpp"
 #include "include/speed_test.hpp"
 #include "include/system_info.hpp"
@@ -40,9 +54,44 @@ void Application::show_help(const std::string& app_name) const {
     std::println("Options:");
     std::println("  -h, --help              Show this help message");
     std::println("  -v, --version           Show version information");
+    std::println("      --cpu               Fixed-work CPU kernels on 1 and all allowed CPUs");
+    std::println("      --jitter[=SECONDS]  Per-CPU scheduling gap probe (default: {}s)",
+                 Config::CPU_JITTER_SECONDS);
+    std::println("      --core-latency      Core-to-core cache-line latency matrix");
+    std::println("      --mem-bandwidth     STREAM copy/scale/add/triad on 1 and all CPUs");
+    std::println("      --mem-latency       Pointer-chase latency sweep from 4 KiB to 1 GiB");
+    std::println("      --disk-sweep        Sweep queue depth x block size after the disk test");
+    std::println("      --jobs[=N]          Run N parallel disk jobs (default: one per CPU)");
+    std::println("      --sqpoll[=CPU]      Compare against an SQPOLL ring (SQ thread on CPU)");
+    std::println("      --iopoll            Compare against an IOPOLL ring (polled completions)");
+    std::println("      --compressible=PCT  Write payload that compresses ~PCT% (default: {})",
+                 Config::IO_PAYLOAD_COMPRESSIBLE_PERCENT);
+    std::println("      --verify            Re-read the main disk test, checking every sector");
+    std::println("      --converge[=PCT]    One disk run, each phase ending once its 95% CI is");
+    std::println("                          within PCT% of the mean (default: {})",
+                 Config::IO_CONVERGE_TOLERANCE * 100.0);
+    std::println("      --noisy[=KIND]      Re-run disk tests under cpu or memory load");
+    std::println("      --metadata[=FILES]  Create/stat/rename/unlink storm (default: {} files)",
+                 Config::IO_META_FILES);
+    std::println("      --small-files[=N]   Write and read back N 4K-64K files (default: {})",
+                 Config::IO_SMALL_FILES);
+    std::println("      --all-mounts        Also test every writable block-device mount");
+    std::println("      --raw-device=DEV    Read-only benchmark of a block device, e.g. /dev/sda");
+    std::println("      --cold-read[=X]     Cold vs warm reads of an X*RAM file (default: {})",
+                 Config::IO_COLD_RAM_MULTIPLE);
+    std::println("      --commit-latency    Measure append + fdatasync commit latency (WAL-style)");
+    std::println("      --engines[=LIST]    Compare I/O engines (default: all of {})",
+                 "uring-direct,uring-buffered,psync,mmap");
+    std::println("      --steady[=SECONDS]  Run a time-based steady-state test (default: {}s)",
+                 Config::IO_STEADY_DURATION_SECONDS);
+    std::println("      --steady-size=MB    File size the steady-state test laps (default: {})",
+                 Config::IO_STEADY_FILE_SIZE_MB);
+    std::println("      --json[=FILE]       Stream results as NDJSON to stdout (report moves to");
+    std::println("                          stderr) or append them to FILE");
     std::println("");
     std::println("Examples:");
     std::println("  {}                   # Run VPS profiling", app_name);
+    std::println("  {} --disk-sweep      # Also map where the disk saturates", app_name);
 }
 
 void Application::show_version() const {
@@ -52,6 +101,16 @@ void Application::show_version() const {
 }
 
 int Application::run(int argc, char* argv[]) {
+    std::optional<JsonReporter> json_out;
+    auto emit = [&](std::string_view type, const json& data) {
+        if (json_out)
+            json_out->emit(type, data);
+    };
+    auto emit_error = [&](std::string_view benchmark, std::string_view message) {
+        if (json_out)
+            json_out->emit_error(benchmark, message);
+    };
+
     try {
         SignalGuard signal_guard;
         HttpContext http_context;
@@ -72,6 +131,220 @@ int Application::run(int argc, char* argv[]) {
             } else if (arg == "-v" || arg == "--version") {
                 show_version();
                 return 0;
+            } else if (arg == "--disk-sweep") {
+                options_.disk_sweep = true;
+            } else if (arg == "--sqpoll" || arg.starts_with("--sqpoll=")) {
+                options_.polled_disk.sqpoll = true;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto cpu = parse_number<int>(std::string_view(arg).substr(eq + 1));
+                    if (!cpu || *cpu < 0) {
+                        std::println(stderr,
+                                     "{}Error: Invalid CPU for --sqpoll: '{}'{}",
+                                     Color::RED,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.polled_disk.sqpoll_cpu = *cpu;
+                }
+            } else if (arg == "--jobs" || arg.starts_with("--jobs=")) {
+                options_.disk_jobs =
+                    std::min(static_cast<int>(allowed_cpus().size()), Config::IO_MULTI_JOB_MAX);
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto jobs = parse_number<int>(std::string_view(arg).substr(eq + 1));
+                    if (!jobs || *jobs < 1 || *jobs > Config::IO_MULTI_JOB_MAX) {
+                        std::println(stderr,
+                                     "{}Error: --jobs expects 1-{}, got '{}'{}",
+                                     Color::RED,
+                                     Config::IO_MULTI_JOB_MAX,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.disk_jobs = *jobs;
+                }
+            } else if (arg == "--iopoll") {
+                options_.polled_disk.iopoll = true;
+            } else if (arg.starts_with("--compressible=")) {
+                auto pct = parse_number<int>(std::string_view(arg).substr(arg.find('=') + 1));
+                if (!pct || *pct < 0 || *pct > 100) {
+                    std::println(stderr,
+                                 "{}Error: --compressible expects 0-100, got '{}'{}",
+                                 Color::RED,
+                                 arg.substr(arg.find('=') + 1),
+                                 Color::RESET);
+                    return 1;
+                }
+                options_.disk.compressible_percent = *pct;
+                options_.polled_disk.compressible_percent = *pct;
+            } else if (arg == "--verify") {
+                options_.disk.verify = true;
+            } else if (arg == "--converge" || arg.starts_with("--converge=")) {
+                options_.disk.converge_tolerance = Config::IO_CONVERGE_TOLERANCE;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto pct = parse_number<double>(std::string_view(arg).substr(eq + 1));
+                    if (!pct || *pct <= 0.0 || *pct > 50.0) {
+                        std::println(stderr,
+                                     "{}Error: --converge expects a percentage in (0, 50], got "
+                                     "'{}'{}",
+                                     Color::RED,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.disk.converge_tolerance = *pct / 100.0;
+                }
+            } else if (arg == "--noisy" || arg.starts_with("--noisy=")) {
+                options_.disk_noise = NoiseKind::Cpu;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    options_.disk_noise =
+                        NoisyNeighbor::parse_kind(std::string_view(arg).substr(eq + 1));
+                    if (!options_.disk_noise) {
+                        std::println(stderr,
+                                     "{}Error: --noisy expects cpu or memory, got '{}'{}",
+                                     Color::RED,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                }
+            } else if (arg == "--metadata" || arg.starts_with("--metadata=")) {
+                options_.metadata_files = Config::IO_META_FILES;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto count = parse_number<int>(std::string_view(arg).substr(eq + 1));
+                    if (!count || *count < 1 || *count > Config::IO_META_MAX_FILES) {
+                        std::println(stderr,
+                                     "{}Error: --metadata expects 1-{} files, got '{}'{}",
+                                     Color::RED,
+                                     Config::IO_META_MAX_FILES,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.metadata_files = *count;
+                }
+            } else if (arg == "--small-files" || arg.starts_with("--small-files=")) {
+                options_.small_files = Config::IO_SMALL_FILES;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto count = parse_number<int>(std::string_view(arg).substr(eq + 1));
+                    if (!count || *count < 1 || *count > Config::IO_SMALL_MAX_FILES) {
+                        std::println(stderr,
+                                     "{}Error: --small-files expects 1-{} files, got '{}'{}",
+                                     Color::RED,
+                                     Config::IO_SMALL_MAX_FILES,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.small_files = *count;
+                }
+            } else if (arg == "--all-mounts") {
+                options_.disk_all_mounts = true;
+            } else if (arg.starts_with("--raw-device=")) {
+                options_.raw_device = arg.substr(arg.find('=') + 1);
+                if (options_.raw_device.empty()) {
+                    std::println(
+                        stderr, "{}Error: --raw-device expects a path{}", Color::RED, Color::RESET);
+                    return 1;
+                }
+            } else if (arg == "--cold-read" || arg.starts_with("--cold-read=")) {
+                options_.cold_ram_multiple = Config::IO_COLD_RAM_MULTIPLE;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto multiple = parse_number<double>(std::string_view(arg).substr(eq + 1));
+                    if (!multiple || *multiple < 1.0 ||
+                        *multiple > Config::IO_COLD_MAX_RAM_MULTIPLE) {
+                        std::println(stderr,
+                                     "{}Error: --cold-read expects 1-{}, got '{}'{}",
+                                     Color::RED,
+                                     Config::IO_COLD_MAX_RAM_MULTIPLE,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.cold_ram_multiple = *multiple;
+                }
+            } else if (arg == "--commit-latency") {
+                options_.disk_commit = true;
+            } else if (arg == "--engines" || arg.starts_with("--engines=")) {
+                options_.disk_engines.assign(DiskBenchmark::ALL_ENGINES.begin(),
+                                             DiskBenchmark::ALL_ENGINES.end());
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    options_.disk_engines.clear();
+                    auto names = std::string_view(arg).substr(eq + 1);
+                    for (auto part : names | std::views::split(',')) {
+                        std::string_view name(part.begin(), part.end());
+                        auto engine = DiskBenchmark::parse_engine(name);
+                        if (!engine) {
+                            std::println(stderr,
+                                         "{}Error: Unknown engine for --engines: '{}'{}",
+                                         Color::RED,
+                                         name,
+                                         Color::RESET);
+                            return 1;
+                        }
+                        options_.disk_engines.push_back(*engine);
+                    }
+                }
+            } else if (arg == "--steady" || arg.starts_with("--steady=")) {
+                options_.steady_seconds = Config::IO_STEADY_DURATION_SECONDS;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto secs = parse_number<int>(std::string_view(arg).substr(eq + 1));
+                    if (!secs || *secs < 1 || *secs > Config::IO_STEADY_MAX_DURATION_SECONDS) {
+                        std::println(stderr,
+                                     "{}Error: --steady expects 1-{} seconds, got '{}'{}",
+                                     Color::RED,
+                                     Config::IO_STEADY_MAX_DURATION_SECONDS,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.steady_seconds = *secs;
+                }
+            } else if (arg.starts_with("--steady-size=")) {
+                auto size = parse_number<int>(std::string_view(arg).substr(arg.find('=') + 1));
+                if (!size || *size < 1) {
+                    std::println(stderr,
+                                 "{}Error: Invalid size for --steady-size: '{}'{}",
+                                 Color::RED,
+                                 arg.substr(arg.find('=') + 1),
+                                 Color::RESET);
+                    return 1;
+                }
+                options_.steady_size_mb = *size;
+            } else if (arg == "--jitter" || arg.starts_with("--jitter=")) {
+                options_.jitter_seconds = Config::CPU_JITTER_SECONDS;
+                if (auto eq = arg.find('='); eq != std::string::npos) {
+                    auto secs = parse_number<int>(std::string_view(arg).substr(eq + 1));
+                    if (!secs || *secs < 1 || *secs > Config::CPU_JITTER_MAX_SECONDS) {
+                        std::println(stderr,
+                                     "{}Error: --jitter expects 1-{} seconds, got '{}'{}",
+                                     Color::RED,
+                                     Config::CPU_JITTER_MAX_SECONDS,
+                                     arg.substr(eq + 1),
+                                     Color::RESET);
+                        return 1;
+                    }
+                    options_.jitter_seconds = *secs;
+                }
+            } else if (arg == "--cpu") {
+                options_.cpu_benchmark = true;
+            } else if (arg == "--core-latency") {
+                options_.core_latency = true;
+            } else if (arg == "--mem-bandwidth") {
+                options_.mem_bandwidth = true;
+            } else if (arg == "--mem-latency") {
+                options_.mem_latency = true;
+            } else if (arg == "--json") {
+                options_.json_path = "-";
+            } else if (arg.starts_with("--json=")) {
+                options_.json_path = arg.substr(arg.find('=') + 1);
+                if (options_.json_path.empty()) {
+                    std::println(stderr,
+                                 "{}Error: --json= expects a file name{}",
+                                 Color::RED,
+                                 Color::RESET);
+                    return 1;
+                }
             } else {
                 std::println(
                     stderr, "{}Error: Unknown option '{}'{}", Color::RED, arg, Color::RESET);
@@ -80,6 +353,39 @@ int Application::run(int argc, char* argv[]) {
             }
         }
 
+        if (options_.json_path == "-") {
+            // NDJSON owns stdout so it can be piped; the human-readable report goes to stderr.
+            // CLOEXEC keeps the speedtest child from holding the consumer's pipe open.
+            int json_fd = ::fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0);
+            if (json_fd < 0 || ::dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+                std::println(stderr,
+                             "{}Error: Cannot redirect stdout for --json: {}{}",
+                             Color::RED,
+                             std::system_category().message(errno),
+                             Color::RESET);
+                return 1;
+            }
+            json_out.emplace(JsonReporter::adopt(FileDescriptor(json_fd)));
+        } else if (!options_.json_path.empty()) {
+            auto opened = JsonReporter::open(options_.json_path);
+            if (!opened) {
+                std::println(stderr, "{}Error: {}{}", Color::RED, opened.error(), Color::RESET);
+                return 1;
+            }
+            json_out.emplace(std::move(*opened));
+        }
+        if (json_out) {
+            // A consumer that exits early must surface as EPIPE, not kill the run before
+            // the test files are cleaned up.
+            ::signal(SIGPIPE, SIG_IGN);
+        }
+
+        emit("start",
+             {{"app", Config::APP_NAME},
+              {"version", Config::APP_VERSION},
+              {"args", std::vector<std::string>(argv + std::min(argc, 1), argv + argc)},
+              {"timestamp", std::format("{:%FT%TZ}", floor<seconds>(system_clock::now()))}});
+
         HttpClient http;
         auto start_time = high_resolution_clock::now();
 
@@ -97,59 +403,73 @@ int Application::run(int argc, char* argv[]) {
         std::println(" {:<{}} : ./{}", "Usage", Config::APP_AUTHOR_LABEL_WIDTH, app_name);
         print_line();
 
+        const std::string cpu_model = SystemInfo::get_model_name();
+        const std::string cpu_cores = SystemInfo::get_cpu_cores_freq();
+        const std::string cpu_cache = SystemInfo::get_cpu_cache();
+        const bool aes = SystemInfo::has_aes();
+        const bool vmx = SystemInfo::has_vmx();
+
         std::println(" -> {}", Color::colorize("CPU & Hardware", Color::BOLD));
         std::println(" {:<{}} : {}",
                      "CPU Model",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_model_name(), Color::CYAN));
+                     Color::colorize(cpu_model, Color::CYAN));
         std::println(" {:<{}} : {}",
                      "CPU Cores",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_cpu_cores_freq(), Color::CYAN));
+                     Color::colorize(cpu_cores, Color::CYAN));
         std::println(" {:<{}} : {}",
                      "CPU Cache",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_cpu_cache(), Color::CYAN));
+                     Color::colorize(cpu_cache, Color::CYAN));
         std::println(" {:<{}} : {}",
                      "AES-NI",
                      Config::APP_INFO_LABEL_WIDTH,
-                     SystemInfo::has_aes() ? Color::colorize("\u2713 Enabled", Color::GREEN)
-                                           : Color::colorize("\u2717 Disabled", Color::RED));
+                     aes ? Color::colorize("\u2713 Enabled", Color::GREEN)
+                         : Color::colorize("\u2717 Disabled", Color::RED));
         std::println(" {:<{}} : {}",
                      "VM-x/AMD-V",
                      Config::APP_INFO_LABEL_WIDTH,
-                     SystemInfo::has_vmx() ? Color::colorize("\u2713 Enabled", Color::GREEN)
-                                           : Color::colorize("\u2717 Disabled", Color::RED));
+                     vmx ? Color::colorize("\u2713 Enabled", Color::GREEN)
+                         : Color::colorize("\u2717 Disabled", Color::RED));
+
+        const std::string os_name = SystemInfo::get_os();
+        const std::string arch = SystemInfo::get_arch();
+        const std::string kernel = SystemInfo::get_kernel();
+        const std::string tcp_cc = SystemInfo::get_tcp_cc();
+        const std::string virt = SystemInfo::get_virtualization();
+        const std::string uptime = SystemInfo::get_uptime();
+        const std::string load_avg = SystemInfo::get_load_avg();
 
         std::println("\n -> {}", Color::colorize("System Info", Color::BOLD));
         std::println(" {:<{}} : {}",
                      "OS",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_os(), Color::CYAN));
+                     Color::colorize(os_name, Color::CYAN));
         std::println(" {:<{}} : {}",
                      "Arch",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_arch(), Color::YELLOW));
+                     Color::colorize(arch, Color::YELLOW));
         std::println(" {:<{}} : {}",
                      "Kernel",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_kernel(), Color::YELLOW));
+                     Color::colorize(kernel, Color::YELLOW));
         std::println(" {:<{}} : {}",
                      "TCP CC",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_tcp_cc(), Color::YELLOW));
+                     Color::colorize(tcp_cc, Color::YELLOW));
         std::println(" {:<{}} : {}",
                      "Virtualization",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_virtualization(), Color::CYAN));
+                     Color::colorize(virt, Color::CYAN));
         std::println(" {:<{}} : {}",
                      "System Uptime",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_uptime(), Color::CYAN));
+                     Color::colorize(uptime, Color::CYAN));
         std::println(" {:<{}} : {}",
                      "Load Average",
                      Config::APP_INFO_LABEL_WIDTH,
-                     Color::colorize(SystemInfo::get_load_avg(), Color::YELLOW));
+                     Color::colorize(load_avg, Color::YELLOW));
 
         std::error_code ec;
         std::string current_dir = fs::current_path(ec).string();
@@ -211,6 +531,26 @@ int Application::run(int argc, char* argv[]) {
             }
         }
 
+        emit("system",
+             {{"cpu",
+               {{"model", cpu_model},
+                {"cores", cpu_cores},
+                {"cache", cpu_cache},
+                {"aes", aes},
+                {"vmx", vmx}}},
+              {"os", os_name},
+              {"arch", arch},
+              {"kernel", kernel},
+              {"tcp_cc", tcp_cc},
+              {"virtualization", virt},
+              {"uptime", uptime},
+              {"load_avg", load_avg},
+              {"disk_test_path", current_dir},
+              {"disk_device", dev_name},
+              {"disk", disk},
+              {"memory", mem},
+              {"swaps", swaps}});
+
         std::println("\n -> {}", Color::colorize("Network", Color::BOLD));
         bool v4 = http.check_connectivity("ipv4.google.com");
         bool v6 = http.check_connectivity("ipv6.google.com");
@@ -222,6 +562,7 @@ int Application::run(int argc, char* argv[]) {
                    v6 ? Color::colorize("\u2713 Online", Color::GREEN)
                       : Color::colorize("\u2717 Offline", Color::RED));
 
+        json network = {{"ipv4", v4}, {"ipv6", v6}};
         auto ip_res = http.get("https://speed.cloudflare.com/meta");
         if (ip_res) {
             try {
@@ -232,6 +573,12 @@ int Application::run(int argc, char* argv[]) {
                 std::string country = data.value("country", "-");
                 std::string region = data.value("region", "");
 
+                network.update({{"asn", asn},
+                                {"isp", org_name},
+                                {"city", city},
+                                {"country", country},
+                                {"region", region}});
+
                 std::string display_isp = org_name;
                 if (asn != 0 && !org_name.empty()) {
                     display_isp = std::format("AS{} {}", asn, org_name);
@@ -255,43 +602,214 @@ int Application::run(int argc, char* argv[]) {
                                  Color::colorize(region, Color::CYAN));
                 }
             } catch (...) {
+                network["error"] = "IP info parse error";
                 std::println(" {:<{}} : {}",
                              "IP Info",
                              Config::APP_INFO_LABEL_WIDTH,
                              Color::colorize("Parse Error", Color::RED));
             }
         } else {
+            network["error"] = ip_res.error();
             std::println(" {:<{}} : {}",
                          "IP Info",
                          Config::APP_INFO_LABEL_WIDTH,
                          Color::colorize(std::format("Failed: {}", ip_res.error()), Color::RED));
         }
+        emit("network", network);
 
         print_line();
 
         constexpr int io_label_width = Config::IO_LABEL_WIDTH;
+
+        // /proc/stat is sampled around every benchmark phase; steal that shows up only under
+        // load is the hypervisor, not the guest. Each phase takes its own snapshot right
+        // before it starts, so rendering and cleanup between phases never land in a row.
+        std::vector<std::pair<std::string, CpuStealStats>> steal_rows;
+        std::vector<CpuTimes> steal_mark;
+        auto begin_steal = [&] { steal_mark = SystemInfo::get_cpu_times(); };
+        auto record_steal = [&](std::string phase) {
+            auto now = SystemInfo::get_cpu_times();
+            if (!steal_mark.empty() && !now.empty()) {
+                const auto stats = CpuBenchmark::steal_between(steal_mark.front(), now.front());
+                json row = stats;
+                row["phase"] = trim(phase);
+                emit("steal", row);
+                steal_rows.emplace_back(std::move(phase), stats);
+            }
+            steal_mark.clear();
+        };
+
+        if (options_.cpu_benchmark) {
+            std::println("Running CPU Benchmark ({} kernels, 1 and {} threads)...",
+                         CpuBenchmark::ALL_KERNELS.size(),
+                         allowed_cpus().size());
+            auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
+            begin_steal();
+            auto cpu_result = CpuBenchmark::run(progress_cb);
+            std::print("\r\x1b[2K");
+            record_steal(" CPU Benchmark");
+
+            if (cpu_result) {
+                emit("cpu", *cpu_result);
+                CliRenderer::render_cpu_results(*cpu_result, io_label_width);
+            } else {
+                emit_error("cpu", cpu_result.error());
+                std::println("\r{}[!] CPU Benchmark Aborted: {}{}",
+                             Color::RED,
+                             cpu_result.error(),
+                             Color::RESET);
+            }
+        }
+
+        if (options_.jitter_seconds > 0) {
+            std::println("\nRunning Jitter Probe ({}s on {} CPUs)...",
+                         options_.jitter_seconds,
+                         allowed_cpus().size());
+
+            auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
+            begin_steal();
+            auto jitter_result =
+                CpuBenchmark::run_jitter_probe(options_.jitter_seconds, progress_cb);
+            std::print("\r\x1b[2K");
+            record_steal(" Jitter Probe");
+
+            if (jitter_result) {
+                emit("cpu_jitter", *jitter_result);
+                CliRenderer::render_cpu_jitter_results(*jitter_result, io_label_width);
+            } else {
+                emit_error("cpu_jitter", jitter_result.error());
+                std::println("\r{}[!] Jitter Probe Aborted: {}{}",
+                             Color::RED,
+                             jitter_result.error(),
+                             Color::RESET);
+            }
+        }
+
+        if (options_.core_latency) {
+            const auto cpu_count = allowed_cpus().size();
+            std::println("\nRunning Core-to-Core Latency ({} CPU pairs)...",
+                         cpu_count * (cpu_count - 1) / 2);
+
+            auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
+            begin_steal();
+            auto c2c_result = CpuBenchmark::run_core_latency(progress_cb);
+            std::print("\r\x1b[2K");
+            record_steal(" Core-to-Core");
+
+            if (c2c_result) {
+                emit("cpu_core_latency", *c2c_result);
+                CliRenderer::render_core_latency_results(*c2c_result, io_label_width);
+            } else {
+                emit_error("cpu_core_latency", c2c_result.error());
+                std::println("\r{}[!] Core-to-Core Latency Aborted: {}{}",
+                             Color::RED,
+                             c2c_result.error(),
+                             Color::RESET);
+            }
+        }
+
+        if (options_.mem_bandwidth) {
+            std::println("\nRunning Memory Bandwidth Test (STREAM, 1 and {} threads)...",
+                         allowed_cpus().size());
+
+            auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
+            begin_steal();
+            auto mem_result = MemoryBenchmark::run_bandwidth_test(progress_cb);
+            std::print("\r\x1b[2K");
+            record_steal(" Memory Bandwidth");
+
+            if (mem_result) {
+                emit("memory_bandwidth", *mem_result);
+                CliRenderer::render_memory_bandwidth_results(*mem_result, io_label_width);
+            } else {
+                emit_error("memory_bandwidth", mem_result.error());
+                std::println("\r{}[!] Memory Bandwidth Aborted: {}{}",
+                             Color::RED,
+                             mem_result.error(),
+                             Color::RESET);
+            }
+        }
+
+        if (options_.mem_latency) {
+            std::println("\nRunning Memory Latency Sweep (pointer chase, 2M and 4K pages)...");
+
+            auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
+            begin_steal();
+            auto latency_result = MemoryBenchmark::run_latency_sweep(progress_cb);
+            std::print("\r\x1b[2K");
+            record_steal(" Memory Latency");
+
+            if (latency_result) {
+                emit("memory_latency", *latency_result);
+                CliRenderer::render_memory_latency_results(*latency_result, io_label_width);
+            } else {
+                emit_error("memory_latency", latency_result.error());
+                std::println("\r{}[!] Memory Latency Aborted: {}{}",
+                             Color::RED,
+                             latency_result.error(),
+                             Color::RESET);
+            }
+        }
+
+        print_line();
+
+        // The confidence interval stands in for repeated runs when converging.
+        const int disk_io_runs = options_.disk.converge_tolerance > 0 ? 1 : Config::DISK_IO_RUNS;
         std::vector<DiskIORunResult> disk_runs;
-        disk_runs.reserve(Config::DISK_IO_RUNS);
-        std::println("Running I/O Test (1GB File)...");
+        disk_runs.reserve(static_cast<std::size_t>(disk_io_runs));
+        if (options_.disk.converge_tolerance > 0) {
+            std::println("Running I/O Test (up to 1GB File, stop at +/-{:.1f}% 95% CI)...",
+                         options_.disk.converge_tolerance * 100.0);
+        } else {
+            std::println("Running I/O Test (1GB File)...");
+        }
 
         bool disk_error = false;
-        for (int i = 1; i <= Config::DISK_IO_RUNS; ++i) {
+        for (int i = 1; i <= disk_io_runs; ++i) {
             std::string label = std::format(" I/O Speed (Run #{})", i);
             auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
 
-            auto result = DiskBenchmark::run_io_test(Config::DISK_TEST_SIZE_MB, label, progress_cb);
+            begin_steal();
+            auto result = DiskBenchmark::run_io_test(Config::DISK_TEST_SIZE_MB,
+                                                     label,
+                                                     options_.disk,
+                                                     progress_cb);
             std::print("\r\x1b[2K");
+            record_steal(std::format(" I/O Run #{}", i));
 
             if (result) {
-                std::println(" {:<{}}: {}   {}",
+                std::string verify_text;
+                if (result->verified) {
+                    verify_text = "   " + Color::colorize(std::format("Verified {:>8.1f} MB/s",
+                                                                     result->verify_read_mbps),
+                                                         Color::GREEN);
+                }
+                std::println(" {:<{}}: {}   {}{}",
                              result->label,
                              io_label_width,
                              Color::colorize(std::format("Write {:>8.1f} MB/s", result->write_mbps),
                                              Color::YELLOW),
                              Color::colorize(std::format("Read {:>8.1f} MB/s", result->read_mbps),
-                                             Color::CYAN));
+                                             Color::CYAN),
+                             verify_text);
+                if (options_.disk.converge_tolerance > 0) {
+                    // Too few closed intervals give no interval worth printing.
+                    auto ci_text = [](const std::optional<double>& half_width) {
+                        return half_width ? std::format("+/-{:.1f} MB/s", *half_width)
+                                          : std::string("n/a");
+                    };
+                    std::println(" {:<{}}: Write {}   Read {}   ({}{})",
+                                 " 95% CI",
+                                 io_label_width,
+                                 ci_text(result->write_ci_mbps),
+                                 ci_text(result->read_ci_mbps),
+                                 format_bytes(result->bytes_written),
+                                 result->converged ? " written, converged" : " written");
+                }
+                emit("disk_run", *result);
                 disk_runs.push_back(*result);
             } else {
+                emit_error("disk_run", result.error());
                 std::println(
                     "\r{}[!] Disk Test Aborted: {}{}", Color::RED, result.error(), Color::RESET);
                 disk_error = true;
@@ -315,6 +833,418 @@ int Application::run(int argc, char* argv[]) {
                          io_label_width,
                          Color::colorize(std::format("Write {:>8.1f} MB/s", avg_w), Color::YELLOW),
                          Color::colorize(std::format("Read {:>8.1f} MB/s", avg_r), Color::CYAN));
+            if (!disk_runs.empty()) {
+                std::println(" {:<{}}: {}", " I/O Path", io_label_width, disk_runs.back().io_path);
+            }
+            emit("disk_summary",
+                 {{"runs", disk_runs.size()},
+                  {"average_write_mbps", avg_w},
+                  {"average_read_mbps", avg_r}});
+
+            std::vector<std::pair<std::string, LatencyStats>> latency_rows;
+            for (std::size_t i = 0; i < disk_runs.size(); ++i) {
+                latency_rows.emplace_back(std::format(" Run #{} Write", i + 1),
+                                          disk_runs[i].write_latency);
+                latency_rows.emplace_back(std::format(" Run #{} Read", i + 1),
+                                          disk_runs[i].read_latency);
+            }
+            CliRenderer::render_latency_table(latency_rows);
+
+            std::vector<std::pair<std::string, DiskKernelStats>> kernel_rows;
+            for (std::size_t i = 0; i < disk_runs.size(); ++i) {
+                if (disk_runs[i].write_kernel)
+                    kernel_rows.emplace_back(std::format(" Run #{} Write", i + 1),
+                                             *disk_runs[i].write_kernel);
+                if (disk_runs[i].read_kernel)
+                    kernel_rows.emplace_back(std::format(" Run #{} Read", i + 1),
+                                             *disk_runs[i].read_kernel);
+            }
+            CliRenderer::render_kernel_io_table(kernel_rows);
+
+            std::println("\nRunning Random I/O Test ({} File, {}s per pattern)...",
+                         format_bytes(static_cast<std::uint64_t>(Config::IO_RANDOM_FILE_SIZE_MB) *
+                                      1024 * 1024),
+                         Config::IO_RANDOM_PHASE_SECONDS);
+
+            auto progress_cb = CliRenderer::make_progress_callback(io_label_width);
+            begin_steal();
+            auto random_result = DiskBenchmark::run_random_test(options_.disk, progress_cb);
+            std::print("\r\x1b[2K");
+            record_steal(" Random I/O");
+
+            if (random_result) {
+                emit("disk_random", *random_result);
+                CliRenderer::render_disk_random_results(*random_result, io_label_width);
+
+                latency_rows.clear();
+                for (const auto& phase : random_result->phases) {
+                    latency_rows.emplace_back(phase.label, phase.latency);
+                }
+                CliRenderer::render_latency_table(latency_rows);
+            } else {
+                emit_error("disk_random", random_result.error());
+                std::println("\r{}[!] Random I/O Test Aborted: {}{}",
+                             Color::RED,
+                             random_result.error(),
+                             Color::RESET);
+            }
+
+            if (options_.wants_polled_disk()) {
+                std::println("\nRunning Polled Ring Comparison...");
+
+                begin_steal();
+                auto polled = DiskBenchmark::run_io_test(Config::DISK_TEST_SIZE_MB,
+                                                         " I/O Speed (Polled)",
+                                                         options_.polled_disk,
+                                                         progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Polled I/O");
+
+                if (polled) {
+                    emit("disk_polled_run", *polled);
+                    auto delta = [](double polled_mbps, double base_mbps) {
+                        return base_mbps > 0 ? (polled_mbps / base_mbps - 1.0) * 100.0 : 0.0;
+                    };
+                    std::println(
+                        " {:<{}}: {}   {}",
+                        polled->label,
+                        io_label_width,
+                        Color::colorize(std::format("Write {:>8.1f} MB/s", polled->write_mbps),
+                                        Color::YELLOW),
+                        Color::colorize(std::format("Read {:>8.1f} MB/s", polled->read_mbps),
+                                        Color::CYAN));
+                    std::println(" {:<{}}: Write {:>+8.1f} %      Read {:>+8.1f} %",
+                                 " vs Interrupt Avg",
+                                 io_label_width,
+                                 delta(polled->write_mbps, avg_w),
+                                 delta(polled->read_mbps, avg_r));
+                    std::println(" {:<{}}: {}", " I/O Path", io_label_width, polled->io_path);
+                } else {
+                    emit_error("disk_polled_run", polled.error());
+                    std::println("\r{}[!] Polled Disk Test Aborted: {}{}",
+                                 Color::RED,
+                                 polled.error(),
+                                 Color::RESET);
+                }
+
+                begin_steal();
+                auto polled_random =
+                    DiskBenchmark::run_random_test(options_.polled_disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Polled Random I/O");
+
+                if (polled_random) {
+                    emit("disk_polled_random", *polled_random);
+                    CliRenderer::render_disk_random_results(*polled_random, io_label_width);
+                } else {
+                    emit_error("disk_polled_random", polled_random.error());
+                    std::println("\r{}[!] Polled Random I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 polled_random.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.disk_noise) {
+                std::expected<DiskIORunResult, std::string> noisy;
+                std::expected<DiskRandomResult, std::string> noisy_random;
+                std::size_t noise_workers = 0;
+                {
+                    NoisyNeighbor load(*options_.disk_noise);
+                    noise_workers = load.workers();
+                    std::println("\nRunning Noisy-Neighbor I/O Test ({} load on {} threads)...",
+                                 NoisyNeighbor::kind_name(*options_.disk_noise),
+                                 noise_workers);
+
+                    begin_steal();
+                    noisy = DiskBenchmark::run_io_test(Config::DISK_TEST_SIZE_MB,
+                                                       " I/O Speed (Noisy)",
+                                                       options_.disk,
+                                                       progress_cb);
+                    std::print("\r\x1b[2K");
+                    if (noisy)
+                        noisy_random = DiskBenchmark::run_random_test(options_.disk, progress_cb);
+                    std::print("\r\x1b[2K");
+                    record_steal(" Noisy I/O");
+                }
+
+                if (noisy) {
+                    auto delta = [](double loaded, double idle) {
+                        return idle > 0 ? (loaded / idle - 1.0) * 100.0 : 0.0;
+                    };
+
+                    DiskNoisyNeighborResult noisy_result;
+                    noisy_result.load = NoisyNeighbor::kind_name(*options_.disk_noise);
+                    noisy_result.workers = noise_workers;
+                    noisy_result.run = *noisy;
+                    noisy_result.write_percent = delta(noisy->write_mbps, avg_w);
+                    noisy_result.read_percent = delta(noisy->read_mbps, avg_r);
+                    if (noisy_random)
+                        noisy_result.random = *noisy_random;
+                    if (noisy_random && random_result) {
+                        const auto& idle_phases = random_result->phases;
+                        for (const auto& loaded : noisy_random->phases) {
+                            auto idle = std::ranges::find(
+                                idle_phases, loaded.label, &DiskRandomPhaseResult::label);
+                            if (idle == idle_phases.end())
+                                continue;
+                            noisy_result.random_changes.push_back(
+                                {loaded.label,
+                                 delta(loaded.iops, idle->iops),
+                                 delta(loaded.latency.p99_us, idle->latency.p99_us)});
+                        }
+                    }
+
+                    emit("disk_noisy_neighbor", noisy_result);
+                    CliRenderer::render_noisy_neighbor_results(noisy_result, io_label_width);
+                    if (!noisy_random) {
+                        emit_error("disk_noisy_random", noisy_random.error());
+                        std::println("\r{}[!] Noisy-Neighbor Random I/O Test Aborted: {}{}",
+                                     Color::RED,
+                                     noisy_random.error(),
+                                     Color::RESET);
+                    }
+                } else {
+                    emit_error("disk_noisy_neighbor", noisy.error());
+                    std::println("\r{}[!] Noisy-Neighbor I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 noisy.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (!options_.raw_device.empty()) {
+                std::println("\nRunning Raw Device Read Test ({}, read-only)...",
+                             options_.raw_device);
+
+                begin_steal();
+                auto raw_result = DiskBenchmark::run_raw_device_test(
+                    options_.raw_device, options_.disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Raw Device");
+
+                if (raw_result) {
+                    emit("disk_raw_device", *raw_result);
+                    CliRenderer::render_disk_raw_device_results(*raw_result, io_label_width);
+                } else {
+                    emit_error("disk_raw_device", raw_result.error());
+                    std::println("\r{}[!] Raw Device Read Test Aborted: {}{}",
+                                 Color::RED,
+                                 raw_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.disk_all_mounts) {
+                const auto mounts = SystemInfo::get_writable_mounts();
+                std::println("\nRunning Multi-Path I/O Test ({} mounts x {} File)...",
+                             mounts.size(),
+                             format_bytes(static_cast<std::uint64_t>(
+                                              Config::IO_MULTI_PATH_FILE_SIZE_MB) *
+                                          1024 * 1024));
+
+                begin_steal();
+                auto path_result = DiskBenchmark::run_multi_path_test(
+                    mounts, Config::IO_MULTI_PATH_FILE_SIZE_MB, options_.disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Multi-Path I/O");
+
+                if (path_result) {
+                    emit("disk_multi_path", *path_result);
+                    CliRenderer::render_disk_multi_path_results(*path_result, io_label_width);
+                } else {
+                    emit_error("disk_multi_path", path_result.error());
+                    std::println("\r{}[!] Multi-Path I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 path_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.metadata_files > 0) {
+                std::println("\nRunning Metadata Test ({} files)...", options_.metadata_files);
+
+                begin_steal();
+                auto meta_result =
+                    DiskBenchmark::run_metadata_test(options_.metadata_files, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Metadata");
+
+                if (meta_result) {
+                    emit("disk_metadata", *meta_result);
+                    CliRenderer::render_disk_metadata_results(*meta_result, io_label_width);
+                } else {
+                    emit_error("disk_metadata", meta_result.error());
+                    std::println("\r{}[!] Metadata Test Aborted: {}{}",
+                                 Color::RED,
+                                 meta_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.small_files > 0) {
+                std::println("\nRunning Small-File I/O Test ({} files)...", options_.small_files);
+
+                begin_steal();
+                auto small_result = DiskBenchmark::run_small_file_test(
+                    options_.small_files, options_.disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Small Files");
+
+                if (small_result) {
+                    emit("disk_small_files", *small_result);
+                    CliRenderer::render_disk_small_file_results(*small_result, io_label_width);
+                } else {
+                    emit_error("disk_small_files", small_result.error());
+                    std::println("\r{}[!] Small-File I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 small_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.cold_ram_multiple > 0) {
+                std::println("\nRunning Cold-Read I/O Test ({:.1f}x RAM working set)...",
+                             options_.cold_ram_multiple);
+
+                begin_steal();
+                auto cold_result = DiskBenchmark::run_cold_read_test(
+                    options_.cold_ram_multiple, options_.disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Cold Read");
+
+                if (cold_result) {
+                    emit("disk_cold_read", *cold_result);
+                    CliRenderer::render_disk_cold_read_results(*cold_result, io_label_width);
+                } else {
+                    emit_error("disk_cold_read", cold_result.error());
+                    std::println("\r{}[!] Cold-Read I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 cold_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.disk_commit) {
+                std::println("\nRunning Commit Latency Test ({} record sizes, {}s each)...",
+                             Config::IO_COMMIT_RECORD_SIZES.size(),
+                             Config::IO_COMMIT_PHASE_SECONDS);
+
+                begin_steal();
+                auto commit_result = DiskBenchmark::run_commit_test(progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Commit Latency");
+
+                if (commit_result) {
+                    emit("disk_commit", *commit_result);
+                    CliRenderer::render_disk_commit_results(*commit_result, io_label_width);
+                } else {
+                    emit_error("disk_commit", commit_result.error());
+                    std::println("\r{}[!] Commit Latency Test Aborted: {}{}",
+                                 Color::RED,
+                                 commit_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (!options_.disk_engines.empty()) {
+                std::println("\nRunning I/O Engine Comparison ({} engines x {} File)...",
+                             options_.disk_engines.size(),
+                             format_bytes(static_cast<std::uint64_t>(
+                                              Config::IO_ENGINE_FILE_SIZE_MB) *
+                                          1024 * 1024));
+
+                begin_steal();
+                auto engine_result = DiskBenchmark::run_engine_comparison(
+                    options_.disk_engines, options_.disk.compressible_percent, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" I/O Engines");
+
+                if (engine_result) {
+                    emit("disk_engines", *engine_result);
+                    CliRenderer::render_disk_engine_results(*engine_result, io_label_width);
+                } else {
+                    emit_error("disk_engines", engine_result.error());
+                    std::println("\r{}[!] I/O Engine Comparison Aborted: {}{}",
+                                 Color::RED,
+                                 engine_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.disk_jobs > 0) {
+                std::println("\nRunning Multi-Job I/O Test ({} jobs x {} File)...",
+                             options_.disk_jobs,
+                             format_bytes(static_cast<std::uint64_t>(
+                                              Config::IO_MULTI_JOB_FILE_SIZE_MB) *
+                                          1024 * 1024));
+
+                begin_steal();
+                auto multi_result = DiskBenchmark::run_multi_job_test(
+                    options_.disk_jobs, options_.disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Multi-Job I/O");
+
+                if (multi_result) {
+                    emit("disk_multi_job", *multi_result);
+                    CliRenderer::render_disk_multi_job_results(*multi_result, io_label_width);
+                } else {
+                    emit_error("disk_multi_job", multi_result.error());
+                    std::println("\r{}[!] Multi-Job I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 multi_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.steady_seconds > 0) {
+                std::println("\nRunning Steady-State I/O Test ({}s per phase over {} File)...",
+                             options_.steady_seconds,
+                             format_bytes(static_cast<std::uint64_t>(options_.steady_size_mb) *
+                                          1024 * 1024));
+
+                begin_steal();
+                auto steady_result = DiskBenchmark::run_steady_state_test(options_.steady_seconds,
+                                                                          options_.steady_size_mb,
+                                                                          options_.disk,
+                                                                          progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Steady State");
+
+                if (steady_result) {
+                    emit("disk_steady_state", *steady_result);
+                    CliRenderer::render_disk_steady_state_results(*steady_result, io_label_width);
+                } else {
+                    emit_error("disk_steady_state", steady_result.error());
+                    std::println("\r{}[!] Steady-State I/O Test Aborted: {}{}",
+                                 Color::RED,
+                                 steady_result.error(),
+                                 Color::RESET);
+                }
+            }
+
+            if (options_.disk_sweep) {
+                std::println("\nRunning Disk Sweep ({} cells, {}s each, random read)...",
+                             Config::IO_SWEEP_QUEUE_DEPTHS.size() *
+                                 Config::IO_SWEEP_BLOCK_SIZES.size(),
+                             Config::IO_SWEEP_CELL_SECONDS);
+
+                begin_steal();
+                auto sweep_result = DiskBenchmark::run_sweep_test(options_.disk, progress_cb);
+                std::print("\r\x1b[2K");
+                record_steal(" Disk Sweep");
+
+                if (sweep_result) {
+                    emit("disk_sweep", *sweep_result);
+                    CliRenderer::render_disk_sweep_results(*sweep_result);
+                } else {
+                    emit_error("disk_sweep", sweep_result.error());
+                    std::println("\r{}[!] Disk Sweep Aborted: {}{}",
+                                 Color::RED,
+                                 sweep_result.error(),
+                                 Color::RESET);
+                }
+            }
         }
 
         print_line();
@@ -323,13 +1253,25 @@ int Application::run(int argc, char* argv[]) {
         try {
             st.install();
             auto spinner_cb = CliRenderer::make_spinner_callback();
-            auto speed_result = st.run(spinner_cb);
+            begin_steal();
+            auto speed_result = st.run(spinner_cb, [&](const SpeedEntryResult& entry) {
+                emit("speed_entry", entry);
+            });
+            record_steal(" Speedtest");
+            emit("speed_summary",
+                 {{"entries", speed_result.entries.size()},
+                  {"rate_limited", speed_result.rate_limited}});
             CliRenderer::render_speed_results(speed_result);
         } catch (const std::exception& e) {
+            emit_error("speed_test", e.what());
             std::println(stderr, "\n{}Speedtest Error: {}{}", Color::RED, e.what(), Color::RESET);
         }
 
         print_line();
+        CliRenderer::render_steal_table(steal_rows);
+        if (!steal_rows.empty())
+            print_line();
+
         auto end_time = high_resolution_clock::now();
         double elapsed_sec = duration<double>(end_time - start_time).count();
         if (elapsed_sec >= Config::TIME_MINUTES_THRESHOLD) {
@@ -340,8 +1282,10 @@ int Application::run(int argc, char* argv[]) {
         } else {
             std::println(" Finished in        : {:.0f} sec", elapsed_sec);
         }
+        emit("end", {{"elapsed_seconds", elapsed_sec}, {"interrupted", g_interrupted.load()}});
 
     } catch (const std::exception& e) {
+        emit_error("fatal", e.what());
         std::println(stderr, "\n{}Fatal Error: {}{}", Color::RED, e.what(), Color::RESET);
         cleanup_artifacts();
         return 1;
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "include/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::value_at_percentile(double pct) const noexcept {
+    const std::uint64_t total = count();
+    if (total == 0)
+        return 0;
+
+    pct = std::clamp(pct, 0.0, 100.0);
+    auto target = static_cast<std::uint64_t>(std::ceil(pct / 100.0 * static_cast<double>(total)));
+    target = std::max<std::uint64_t>(target, 1);
+
+    const std::uint64_t lowest = min_.load(std::memory_order_relaxed);
+    const std::uint64_t highest = max_.load(std::memory_order_relaxed);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::clamp(bucket_value(i), lowest, highest);
+        }
+    }
+    return highest;
+}
+
+LatencyStats LatencyHistogram::summarize() const noexcept {
+    LatencyStats stats;
+    const std::uint64_t total = count();
+    if (total == 0)
+        return stats;
+
+    auto to_us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+    stats.samples = total;
+    stats.min_us = to_us(min_.load(std::memory_order_relaxed));
+    stats.mean_us = to_us(sum_.load(std::memory_order_relaxed)) / static_cast<double>(total);
+    stats.p50_us = to_us(value_at_percentile(50.0));
+    stats.p90_us = to_us(value_at_percentile(90.0));
+    stats.p99_us = to_us(value_at_percentile(99.0));
+    stats.p999_us = to_us(value_at_percentile(99.9));
+    stats.max_us = to_us(max_.load(std::memory_order_relaxed));
+    return stats;
+}
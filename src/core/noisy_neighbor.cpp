@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "include/noisy_neighbor.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stop_token>
+
+#include "include/affinity.hpp"
+#include "include/config.hpp"
+
+namespace {
+
+void spin_cpu(std::stop_token stop) {
+    std::uint64_t x = 0x9E3779B97F4A7C15;
+    volatile std::uint64_t sink = 0;
+    while (!stop.stop_requested()) {
+        for (int i = 0; i < 1 << 16; ++i) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+        }
+        sink = x;
+    }
+    (void)sink;
+}
+
+// One read-modify-write per cache line keeps the loop bound on memory bandwidth, not on
+// ALU; the running sum goes to a volatile so the stores cannot be elided.
+void stream_memory(std::stop_token stop, std::size_t bytes) {
+    constexpr std::size_t line = 64 / sizeof(std::uint64_t);
+    const std::size_t words = bytes / sizeof(std::uint64_t);
+    auto buffer = std::unique_ptr<std::uint64_t[]>(new (std::nothrow) std::uint64_t[words]());
+    if (!buffer) {
+        spin_cpu(stop);
+        return;
+    }
+
+    volatile std::uint64_t sink = 0;
+    std::uint64_t sum = 0;
+    while (!stop.stop_requested()) {
+        for (std::size_t i = 0; i < words; i += line) {
+            sum += buffer[i];
+            buffer[i] = sum;
+        }
+        sink = sum;
+    }
+    (void)sink;
+}
+
+}  // namespace
+
+NoisyNeighbor::NoisyNeighbor(NoiseKind kind) {
+    const auto cpus = allowed_cpus();
+    const std::size_t count = std::max<std::size_t>(1, cpus.size() - 1);
+    const std::size_t per_worker_bytes =
+        std::max<std::size_t>(Config::NOISY_MEMORY_MIN_WORKER_MB,
+                              Config::NOISY_MEMORY_TOTAL_MB / count) *
+        1024 * 1024;
+
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const int cpu = cpus.size() > 1 ? cpus[i + 1] : cpus[0];
+        workers_.emplace_back([kind, cpu, per_worker_bytes](std::stop_token stop) {
+            pin_current_thread(cpu);
+            switch (kind) {
+                case NoiseKind::Cpu:
+                    spin_cpu(stop);
+                    break;
+                case NoiseKind::Memory:
+                    stream_memory(stop, per_worker_bytes);
+                    break;
+            }
+        });
+    }
+
+    // After the workers are spawned, so a worker that fails to pin keeps the full mask.
+    if (cpus.size() > 1 && ::sched_getaffinity(0, sizeof(saved_affinity_), &saved_affinity_) == 0)
+        restore_affinity_ = pin_current_thread(cpus[0]);
+}
+
+NoisyNeighbor::~NoisyNeighbor() {
+    if (restore_affinity_)
+        ::sched_setaffinity(0, sizeof(saved_affinity_), &saved_affinity_);
+}
+
+std::string_view NoisyNeighbor::kind_name(NoiseKind kind) noexcept {
+    switch (kind) {
+        case NoiseKind::Cpu:
+            return "cpu";
+        case NoiseKind::Memory:
+            return "memory";
+    }
+    return "unknown";
+}
+
+std::optional<NoiseKind> NoisyNeighbor::parse_kind(std::string_view name) noexcept {
+    for (auto kind : {NoiseKind::Cpu, NoiseKind::Memory}) {
+        if (kind_name(kind) == name)
+            return kind;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,772 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "include/cpu_benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+#include "include/affinity.hpp"
+#include "include/config.hpp"
+#include "include/interrupts.hpp"
+#include "include/system_info.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::uint64_t INPUT_SEED = 0x243F6A8885A308D3ULL;
+
+std::uint64_t splitmix64(std::uint64_t& state) noexcept {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Source-like text: integers, decimals, identifiers and quoted strings with separators,
+// drawn at random so the parser's branches cannot be learned. Also compresses ~3x,
+// which keeps zlib on its match-finding path rather than storing raw blocks.
+std::vector<char> make_text(std::size_t bytes) {
+    std::vector<char> text;
+    text.reserve(bytes + 64);
+    std::uint64_t state = INPUT_SEED;
+    constexpr std::string_view separators[] = {", ", ";", "\n", " ", " = ", "(", ")"};
+
+    while (text.size() < bytes) {
+        const std::uint64_t r = splitmix64(state);
+        const unsigned kind = static_cast<unsigned>(r % 100);
+        unsigned length = 1 + static_cast<unsigned>((r >> 8) % 12);
+        if (kind < 35) {
+            if ((r >> 16) % 10 < 3)
+                text.push_back('-');
+            for (unsigned i = 0; i < length; ++i)
+                text.push_back(static_cast<char>('0' + (r >> (20 + i * 3)) % 10));
+        } else if (kind < 50) {
+            for (unsigned i = 0; i < length; ++i)
+                text.push_back(static_cast<char>('0' + (r >> (20 + i * 3)) % 10));
+            text.push_back('.');
+            text.push_back(static_cast<char>('0' + (r >> 56) % 10));
+        } else if (kind < 75) {
+            // Few distinct identifier stems, as in real code and logs.
+            static constexpr std::string_view stems[] = {
+                "value", "index", "buffer", "count", "offset", "request", "node", "tmp"};
+            text.insert(text.end(), stems[(r >> 16) % 8].begin(), stems[(r >> 16) % 8].end());
+            if ((r >> 24) % 2)
+                text.push_back(static_cast<char>('a' + (r >> 28) % 26));
+        } else if (kind < 85) {
+            text.push_back('"');
+            length += static_cast<unsigned>((r >> 40) % 12);
+            for (unsigned i = 0; i < length; ++i) {
+                const std::uint64_t c = splitmix64(state);
+                if (c % 16 == 0) {
+                    text.push_back('\\');
+                    text.push_back('"');
+                } else {
+                    text.push_back(static_cast<char>('a' + c % 26));
+                }
+            }
+            text.push_back('"');
+        }
+        const auto& sep = separators[(r >> 60) % std::size(separators)];
+        text.insert(text.end(), sep.begin(), sep.end());
+    }
+    text.resize(bytes);
+    return text;
+}
+
+// XXH64-style striped multiply/rotate over the buffer; one pass is bound on 64-bit
+// multiplies and rotates rather than on memory (the input fits in L2).
+std::uint64_t hash_pass(std::span<const std::uint8_t> input) noexcept {
+    constexpr std::uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    std::uint64_t acc[4] = {P1 + P2, P2, 0, 0 - P1};
+
+    std::size_t i = 0;
+    for (; i + 32 <= input.size(); i += 32) {
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            std::uint64_t v;
+            std::memcpy(&v, input.data() + i + lane * 8, sizeof(v));
+            acc[lane] = std::rotl(acc[lane] + v * P2, 31) * P1;
+        }
+    }
+
+    std::uint64_t h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) + std::rotl(acc[2], 12) +
+                      std::rotl(acc[3], 18);
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    return h;
+}
+
+// Tokenizes `text` the way a config or log parser would: a data-dependent branch per
+// character class, number accumulation and identifier hashing.
+std::uint64_t parse_pass(std::span<const char> text) noexcept {
+    std::uint64_t checksum = 0;
+    std::size_t i = 0;
+    const std::size_t n = text.size();
+
+    while (i < n) {
+        const char c = text[i];
+        if ((c >= '0' && c <= '9') || c == '-') {
+            const bool negative = c == '-';
+            if (negative)
+                ++i;
+            std::int64_t value = 0;
+            while (i < n && text[i] >= '0' && text[i] <= '9')
+                value = value * 10 + (text[i++] - '0');
+            if (i < n && text[i] == '.') {
+                ++i;
+                while (i < n && text[i] >= '0' && text[i] <= '9')
+                    value = value * 10 + (text[i++] - '0');
+                value ^= 0x5A5A;
+            }
+            checksum += static_cast<std::uint64_t>(negative ? -value : value);
+        } else if ((c >= 'a' && c <= 'z') || c == '_') {
+            std::uint64_t h = 0xCBF29CE484222325ULL;
+            while (i < n && ((text[i] >= 'a' && text[i] <= 'z') || text[i] == '_'))
+                h = (h ^ static_cast<std::uint8_t>(text[i++])) * 0x100000001B3ULL;
+            checksum ^= h;
+        } else if (c == '"') {
+            ++i;
+            std::uint64_t length = 0;
+            while (i < n && text[i] != '"') {
+                i += text[i] == '\\' ? 2u : 1u;
+                ++length;
+            }
+            ++i;
+            checksum += length << 32;
+        } else {
+            checksum = std::rotl(checksum, 1) + static_cast<std::uint8_t>(c);
+            ++i;
+        }
+    }
+    return checksum;
+}
+
+// c += a x b for n x n doubles in i-k-j order, which the compiler vectorizes. The
+// accumulation into c keeps repeated passes from being folded together.
+std::uint64_t matmul_pass(std::span<const double> a,
+                          std::span<const double> b,
+                          std::span<double> c,
+                          std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = 0; k < n; ++k) {
+            const double aik = a[i * n + k];
+            for (std::size_t j = 0; j < n; ++j)
+                c[i * n + j] += aik * b[k * n + j];
+        }
+    }
+    return std::bit_cast<std::uint64_t>(c[0] + c[n * n - 1]);
+}
+
+struct DeflateEnd {
+    void operator()(z_stream* stream) const noexcept {
+        deflateEnd(stream);
+        delete stream;
+    }
+};
+// Heap-held because zlib's internal state points back at the z_stream, so it cannot move.
+using DeflateStream = std::unique_ptr<z_stream, DeflateEnd>;
+
+// One deflate of the whole input through a stream set up once per thread; deflateReset
+// keeps its window and hash tables, so a pass costs compression, not allocation.
+std::uint64_t compress_pass(std::span<const char> input,
+                            std::vector<Bytef>& output,
+                            z_stream& stream) {
+    if (deflateReset(&stream) != Z_OK)
+        return 0;
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+    if (deflate(&stream, Z_FINISH) != Z_STREAM_END)
+        return 0;
+    return stream.total_out;
+}
+
+// Per-thread copy of a kernel's input, so no two threads share cache lines.
+struct Workspace {
+    std::vector<std::uint8_t> bytes;
+    std::vector<char> text;
+    std::vector<double> a, b, c;
+    std::vector<Bytef> compressed;
+    DeflateStream deflate;
+};
+
+Workspace prepare(CpuKernel kernel) {
+    Workspace ws;
+    std::uint64_t state = INPUT_SEED;
+    switch (kernel) {
+        case CpuKernel::IntegerHash:
+            ws.bytes.resize(Config::CPU_HASH_BYTES);
+            for (auto& byte : ws.bytes)
+                byte = static_cast<std::uint8_t>(splitmix64(state));
+            break;
+        case CpuKernel::BranchyParse:
+            ws.text = make_text(Config::CPU_PARSE_BYTES);
+            break;
+        case CpuKernel::FloatMatmul: {
+            constexpr std::size_t cells = Config::CPU_MATMUL_N * Config::CPU_MATMUL_N;
+            ws.a.resize(cells);
+            ws.b.resize(cells);
+            ws.c.assign(cells, 0.0);
+            for (std::size_t i = 0; i < cells; ++i) {
+                ws.a[i] = static_cast<double>(splitmix64(state) >> 11) * 0x1.0p-53 - 0.5;
+                ws.b[i] = static_cast<double>(splitmix64(state) >> 11) * 0x1.0p-53 - 0.5;
+            }
+            break;
+        }
+        case CpuKernel::Compression:
+            ws.text = make_text(Config::CPU_COMPRESS_BYTES);
+            ws.compressed.resize(compressBound(static_cast<uLong>(ws.text.size())));
+            ws.deflate = DeflateStream(new z_stream{});
+            if (deflateInit(ws.deflate.get(), Config::CPU_COMPRESS_LEVEL) != Z_OK)
+                ws.deflate.reset();
+            break;
+    }
+    return ws;
+}
+
+std::uint64_t run_pass(CpuKernel kernel, Workspace& ws) {
+    switch (kernel) {
+        case CpuKernel::IntegerHash:
+            return hash_pass(ws.bytes);
+        case CpuKernel::BranchyParse:
+            return parse_pass(ws.text);
+        case CpuKernel::FloatMatmul:
+            return matmul_pass(ws.a, ws.b, ws.c, Config::CPU_MATMUL_N);
+        case CpuKernel::Compression:
+            return ws.deflate ? compress_pass(ws.text, ws.compressed, *ws.deflate) : 0;
+    }
+    return 0;
+}
+
+// Work per pass in the kernel's unit: MiB of input, or GFLOP for the matrix multiply.
+double units_per_pass(CpuKernel kernel) noexcept {
+    constexpr double mib = 1024.0 * 1024.0;
+    switch (kernel) {
+        case CpuKernel::IntegerHash:
+            return static_cast<double>(Config::CPU_HASH_BYTES) / mib;
+        case CpuKernel::BranchyParse:
+            return static_cast<double>(Config::CPU_PARSE_BYTES) / mib;
+        case CpuKernel::FloatMatmul: {
+            const auto n = static_cast<double>(Config::CPU_MATMUL_N);
+            return 2.0 * n * n * n / 1e9;
+        }
+        case CpuKernel::Compression:
+            return static_cast<double>(Config::CPU_COMPRESS_BYTES) / mib;
+    }
+    return 0.0;
+}
+
+std::size_t kernel_index(CpuKernel kernel) noexcept {
+    return static_cast<std::size_t>(
+        std::ranges::find(CpuBenchmark::ALL_KERNELS, kernel) - CpuBenchmark::ALL_KERNELS.begin());
+}
+
+// Runs the kernel's fixed passes on one pinned thread per entry of `cpus`, all starting
+// together, and returns the aggregate rate from the first start to the last finish.
+std::expected<double, std::string> run_kernel(
+    CpuKernel kernel,
+    std::span<const int> cpus,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto passes = static_cast<std::uint64_t>(
+        std::max(1, Config::CPU_KERNEL_PASSES[kernel_index(kernel)]));
+    const auto thread_count = static_cast<std::ptrdiff_t>(cpus.size());
+    const std::string label =
+        std::format(" {} ({}T)", CpuBenchmark::kernel_name(kernel), thread_count);
+
+    std::array<high_resolution_clock::time_point, 2> marks{};
+    std::atomic<std::size_t> mark_count{0};
+    std::barrier sync(thread_count, [&]() noexcept {
+        const auto index = mark_count.load(std::memory_order_relaxed);
+        if (index < marks.size())
+            marks[index] = high_resolution_clock::now();
+        mark_count.store(index + 1, std::memory_order_release);
+    });
+
+    std::atomic<std::uint64_t> done{0};
+    std::atomic<std::uint64_t> checksum{0};
+    std::atomic<bool> abort{false};
+    const std::uint64_t total = passes * cpus.size();
+
+    run_pinned_workers(
+        cpus,
+        cpus.size(),
+        [&](std::size_t) {
+            Workspace ws = prepare(kernel);
+            std::uint64_t local = 0;
+
+            sync.arrive_and_wait();
+            for (std::uint64_t p = 0; p < passes; ++p) {
+                if (abort.load(std::memory_order_relaxed))
+                    break;
+                local ^= run_pass(kernel, ws);
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+            sync.arrive_and_wait();
+
+            checksum.fetch_xor(local, std::memory_order_relaxed);
+        },
+        [&] {
+            if (g_interrupted || stop.stop_requested())
+                abort.store(true, std::memory_order_relaxed);
+            if (progress_cb)
+                progress_cb(static_cast<std::size_t>(done.load()), total, label);
+        });
+
+    if (abort.load() || g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+
+    const duration<double> secs = marks[1] - marks[0];
+    if (secs.count() <= 0)
+        return std::unexpected(std::format("{}: timer did not advance", label));
+    return units_per_pass(kernel) * static_cast<double>(passes * cpus.size()) / secs.count();
+}
+
+double geometric_mean(std::span<const double> values) {
+    if (values.empty())
+        return 0.0;
+    double log_sum = 0.0;
+    for (double v : values)
+        log_sum += std::log(std::max(v, 1e-9));
+    return std::exp(log_sum / static_cast<double>(values.size()));
+}
+
+// The line both threads bounce, and the abort flag on a line of its own so polling it does
+// not add traffic to the one being measured.
+struct alignas(64) PingLine {
+    std::atomic<std::uint64_t> value{0};
+};
+
+struct alignas(64) AbortLine {
+    std::atomic<bool> flag{false};
+};
+
+// Written in place of the first answer when the pong thread could not pin, so the pinger
+// learns of it without polling anything beyond the line it already spins on.
+constexpr std::uint64_t PONG_PIN_FAILED = ~std::uint64_t{0};
+
+// Best-batch round-trip time between two CPUs. The calling thread pings from `from` and
+// a second thread pinned to `to` answers, each waiting for the other's increment.
+std::expected<double, std::string> measure_round_trip(int from,
+                                                      int to,
+                                                      const std::atomic<bool>& abort) {
+    const auto rounds = static_cast<std::uint64_t>(std::max(1, Config::CPU_C2C_ROUND_TRIPS));
+    const auto samples = static_cast<std::uint64_t>(std::max(1, Config::CPU_C2C_SAMPLES));
+    if (!pin_current_thread(from))
+        return std::unexpected(std::format("Cannot pin to CPU {}", from));
+    PingLine line;
+
+    std::jthread pong([&] {
+        if (!pin_current_thread(to)) {
+            while (line.value.load(std::memory_order_acquire) != 1) {
+                if (abort.load(std::memory_order_relaxed))
+                    return;
+            }
+            line.value.store(PONG_PIN_FAILED, std::memory_order_release);
+            return;
+        }
+        for (std::uint64_t seq = 1; seq < rounds * samples * 2; seq += 2) {
+            while (line.value.load(std::memory_order_acquire) != seq) {
+                if (abort.load(std::memory_order_relaxed))
+                    return;
+            }
+            line.value.store(seq + 1, std::memory_order_release);
+        }
+    });
+
+    auto best = duration<double, std::nano>::max();
+    std::uint64_t seq = 0;
+    for (std::uint64_t s = 0; s < samples; ++s) {
+        const auto begin = high_resolution_clock::now();
+        for (std::uint64_t r = 0; r < rounds; ++r, seq += 2) {
+            line.value.store(seq + 1, std::memory_order_release);
+            std::uint64_t seen;
+            while ((seen = line.value.load(std::memory_order_acquire)) != seq + 2) {
+                if (seen == PONG_PIN_FAILED)
+                    return std::unexpected(std::format("Cannot pin to CPU {}", to));
+                if (abort.load(std::memory_order_relaxed))
+                    return std::unexpected("Operation interrupted by user");
+            }
+        }
+        best = std::min<duration<double, std::nano>>(best, high_resolution_clock::now() - begin);
+    }
+    return best.count() / static_cast<double>(rounds);
+}
+
+// The hardware threads sharing `cpu`'s physical core as sysfs lists them, or empty when
+// the topology is not exposed.
+std::string thread_siblings(int cpu) {
+    std::ifstream file(
+        std::format("/sys/devices/system/cpu/cpu{}/topology/thread_siblings_list", cpu));
+    std::string list;
+    std::getline(file, list);
+    return list;
+}
+
+// Splits the CPUs at the highest gap of at least CPU_C2C_DOMAIN_GAP_RATIO between sorted
+// pair latencies: pairs at or below it join a domain. The highest rather than the widest
+// gap, so SMT siblings do not end up as domains of their own inside a CCD. On a single-CCD
+// host with SMT the highest gap is the sibling one; a split whose shared domains each sit on
+// one physical core is therefore collapsed into a single domain.
+void group_domains(CpuCoreLatencyResult& result) {
+    const std::size_t n = result.cpus.size();
+    std::vector<double> sorted;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j)
+            sorted.push_back(result.round_trip_ns[i][j]);
+    }
+    std::ranges::sort(sorted);
+
+    result.domain_threshold_ns = sorted.empty() ? 0.0 : sorted.back();
+    for (std::size_t k = sorted.size(); k-- > 1;) {
+        if (sorted[k] >= sorted[k - 1] * Config::CPU_C2C_DOMAIN_GAP_RATIO) {
+            result.domain_threshold_ns = sorted[k - 1];
+            break;
+        }
+    }
+
+    std::vector<int> domain_of(n, -1);
+    int domains = 0;
+    for (std::size_t seed = 0; seed < n; ++seed) {
+        if (domain_of[seed] >= 0)
+            continue;
+        std::vector<std::size_t> stack = {seed};
+        domain_of[seed] = domains;
+        while (!stack.empty()) {
+            const std::size_t i = stack.back();
+            stack.pop_back();
+            for (std::size_t j = 0; j < n; ++j) {
+                if (domain_of[j] < 0 && result.round_trip_ns[i][j] <= result.domain_threshold_ns) {
+                    domain_of[j] = domains;
+                    stack.push_back(j);
+                }
+            }
+        }
+        ++domains;
+    }
+
+    if (domains > 1) {
+        std::vector<std::string> siblings(n);
+        for (std::size_t i = 0; i < n; ++i)
+            siblings[i] = thread_siblings(result.cpus[i]);
+        bool shares = false;
+        bool spans_cores = false;
+        for (std::size_t i = 0; i < n && !spans_cores; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                if (domain_of[i] != domain_of[j])
+                    continue;
+                shares = true;
+                if (siblings[i].empty() || siblings[i] != siblings[j]) {
+                    spans_cores = true;
+                    break;
+                }
+            }
+        }
+        if (shares && !spans_cores) {
+            std::ranges::fill(domain_of, 0);
+            domains = 1;
+            result.domain_threshold_ns = sorted.back();
+        }
+    }
+
+    result.domains.assign(static_cast<std::size_t>(domains), {});
+    std::vector<double> inside_sum(result.domains.size(), 0.0);
+    std::vector<std::size_t> inside_pairs(result.domains.size(), 0);
+    double between_sum = 0.0;
+    std::size_t between_pairs = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto d = static_cast<std::size_t>(domain_of[i]);
+        result.domains[d].cpus.push_back(result.cpus[i]);
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (domain_of[j] == domain_of[i]) {
+                inside_sum[d] += result.round_trip_ns[i][j];
+                ++inside_pairs[d];
+            } else {
+                between_sum += result.round_trip_ns[i][j];
+                ++between_pairs;
+            }
+        }
+    }
+    for (std::size_t d = 0; d < result.domains.size(); ++d) {
+        if (inside_pairs[d] > 0)
+            result.domains[d].mean_round_trip_ns =
+                inside_sum[d] / static_cast<double>(inside_pairs[d]);
+    }
+    result.inter_domain_ns = between_pairs > 0 ? between_sum / static_cast<double>(between_pairs)
+                                               : 0.0;
+}
+
+}  // namespace
+
+std::string_view CpuBenchmark::kernel_name(CpuKernel kernel) noexcept {
+    switch (kernel) {
+        case CpuKernel::IntegerHash:
+            return "Integer Hash";
+        case CpuKernel::BranchyParse:
+            return "Branchy Parse";
+        case CpuKernel::FloatMatmul:
+            return "FP Matmul";
+        case CpuKernel::Compression:
+            return "Compression";
+    }
+    return "unknown";
+}
+
+std::string_view CpuBenchmark::kernel_unit(CpuKernel kernel) noexcept {
+    return kernel == CpuKernel::FloatMatmul ? "GFLOPS" : "MB/s";
+}
+
+std::expected<CpuBenchmarkResult, std::string> CpuBenchmark::run(
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto cpus = allowed_cpus();
+
+    CpuBenchmarkResult result;
+    result.threads = static_cast<int>(cpus.size());
+
+    std::vector<double> single_scores;
+    std::vector<double> multi_scores;
+    for (CpuKernel kernel : ALL_KERNELS) {
+        auto single = run_kernel(kernel, std::span(cpus).first(1), progress_cb, stop);
+        if (!single)
+            return std::unexpected(single.error());
+
+        // On one CPU the all-core run would only repeat the single-thread one.
+        double multi = *single;
+        if (cpus.size() > 1) {
+            auto all = run_kernel(kernel, cpus, progress_cb, stop);
+            if (!all)
+                return std::unexpected(all.error());
+            multi = *all;
+        }
+
+        const double reference = Config::CPU_REFERENCE_RATES[kernel_index(kernel)];
+        CpuKernelResult row;
+        row.name = std::string(kernel_name(kernel));
+        row.unit = std::string(kernel_unit(kernel));
+        row.single_rate = *single;
+        row.multi_rate = multi;
+        row.single_score = reference > 0 ? *single / reference * 1000.0 : 0.0;
+        row.multi_score = reference > 0 ? multi / reference * 1000.0 : 0.0;
+        row.scaling_efficiency = *single > 0 ? multi / (*single * result.threads) : 0.0;
+        single_scores.push_back(row.single_score);
+        multi_scores.push_back(row.multi_score);
+        result.kernels.push_back(std::move(row));
+    }
+
+    result.single_score = geometric_mean(single_scores);
+    result.multi_score = geometric_mean(multi_scores);
+    result.scaling_efficiency = result.single_score > 0
+                                    ? result.multi_score / (result.single_score * result.threads)
+                                    : 0.0;
+    return result;
+}
+
+CpuStealStats CpuBenchmark::steal_between(const CpuTimes& before, const CpuTimes& after) noexcept {
+    // iowait is known to step backwards on tickless kernels, so clamp every delta at zero.
+    auto delta = [](std::uint64_t from, std::uint64_t to) {
+        return to > from ? static_cast<double>(to - from) : 0.0;
+    };
+
+    CpuStealStats stats;
+    const double total = delta(before.total(), after.total());
+    if (total <= 0)
+        return stats;
+    stats.steal_percent = delta(before.steal, after.steal) / total * 100.0;
+    stats.iowait_percent = delta(before.iowait, after.iowait) / total * 100.0;
+    return stats;
+}
+
+std::expected<CpuJitterResult, std::string> CpuBenchmark::run_jitter_probe(
+    int seconds,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    constexpr auto& edges = Config::CPU_JITTER_BUCKETS_US;
+    const auto cpus = allowed_cpus();
+    const auto thread_count = static_cast<std::ptrdiff_t>(cpus.size());
+    const auto probe_time =
+        std::chrono::seconds(std::clamp(seconds, 1, Config::CPU_JITTER_MAX_SECONDS));
+    const auto threshold =
+        duration_cast<steady_clock::duration>(duration<double, std::micro>(edges.front()));
+
+    struct CoreGaps {
+        std::uint64_t gaps = 0;
+        steady_clock::duration max_gap{};
+        steady_clock::duration lost{};
+        std::array<std::uint64_t, edges.size()> histogram{};
+    };
+    std::vector<CoreGaps> per_core(cpus.size());
+
+    // The first barrier completion snapshots /proc/stat and fixes the deadline once every
+    // thread is pinned; the second snapshots again once the last one has stopped.
+    std::vector<CpuTimes> times_before;
+    std::vector<CpuTimes> times_after;
+    steady_clock::time_point start{};
+    steady_clock::time_point finish{};
+    bool started = false;
+    std::barrier sync(thread_count, [&]() noexcept {
+        if (!started) {
+            times_before = SystemInfo::get_cpu_times();
+            start = steady_clock::now();
+            started = true;
+        } else {
+            finish = steady_clock::now();
+            times_after = SystemInfo::get_cpu_times();
+        }
+    });
+
+    std::atomic<bool> abort{false};
+    const auto total_ms = static_cast<std::size_t>(milliseconds(probe_time).count());
+    const auto begin = steady_clock::now();
+
+    // Polls rarely: every wakeup of this thread lands on a probed CPU as a small gap.
+    run_pinned_workers(
+        cpus,
+        cpus.size(),
+        [&](std::size_t t) {
+            CoreGaps& core = per_core[t];
+
+            sync.arrive_and_wait();
+            const auto deadline = start + probe_time;
+            auto prev = steady_clock::now();
+            for (;;) {
+                const auto now = steady_clock::now();
+                const auto gap = now - prev;
+                prev = now;
+                if (gap >= threshold) [[unlikely]] {
+                    const double gap_us = duration<double, std::micro>(gap).count();
+                    std::size_t bucket = 0;
+                    while (bucket + 1 < edges.size() && gap_us >= edges[bucket + 1])
+                        ++bucket;
+                    ++core.histogram[bucket];
+                    ++core.gaps;
+                    core.lost += gap;
+                    core.max_gap = std::max(core.max_gap, gap);
+                }
+                if (now >= deadline || abort.load(std::memory_order_relaxed))
+                    break;
+            }
+            sync.arrive_and_wait();
+        },
+        [&] {
+            if (g_interrupted || stop.stop_requested())
+                abort.store(true, std::memory_order_relaxed);
+            if (progress_cb) {
+                const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - begin);
+                progress_cb(std::min(static_cast<std::size_t>(elapsed.count()), total_ms),
+                            total_ms,
+                            " Jitter Probe");
+            }
+        },
+        milliseconds(500));
+
+    if (abort.load() || g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+
+    CpuJitterResult result;
+    result.duration_seconds = static_cast<int>(probe_time.count());
+    result.bucket_edges_us.assign(edges.begin(), edges.end());
+
+    const double elapsed_us = duration<double, std::micro>(finish - start).count();
+    auto find_cpu = [](const std::vector<CpuTimes>& times, int cpu) -> const CpuTimes* {
+        auto it = std::ranges::find(times, cpu, &CpuTimes::cpu);
+        return it == times.end() ? nullptr : &*it;
+    };
+
+    for (std::size_t t = 0; t < cpus.size(); ++t) {
+        const CoreGaps& core = per_core[t];
+        CpuJitterCoreResult row;
+        row.cpu = cpus[t];
+        row.gaps = core.gaps;
+        row.max_gap_us = duration<double, std::micro>(core.max_gap).count();
+        row.lost_percent =
+            elapsed_us > 0 ? duration<double, std::micro>(core.lost).count() / elapsed_us * 100.0
+                           : 0.0;
+        const CpuTimes* before = find_cpu(times_before, cpus[t]);
+        const CpuTimes* after = find_cpu(times_after, cpus[t]);
+        if (before && after)
+            row.steal_percent = steal_between(*before, *after).steal_percent;
+        row.histogram.assign(core.histogram.begin(), core.histogram.end());
+        result.cores.push_back(std::move(row));
+    }
+    return result;
+}
+
+std::expected<CpuCoreLatencyResult, std::string> CpuBenchmark::run_core_latency(
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto cpus = allowed_cpus();
+    if (cpus.size() < 2)
+        return std::unexpected("Needs at least two allowed CPUs");
+
+    const std::size_t n = cpus.size();
+    CpuCoreLatencyResult result;
+    result.cpus = cpus;
+    result.round_trip_ns.assign(n, std::vector<double>(n, 0.0));
+
+    const std::size_t total = n * (n - 1) / 2;
+    std::atomic<std::size_t> done{0};
+    AbortLine abort;
+    std::atomic<bool> finished{false};
+    std::string error;
+    {
+        // Pairs run one at a time so no two measurements share a core or a link.
+        std::jthread worker([&] {
+            for (std::size_t i = 0; i < n && !abort.flag.load(std::memory_order_relaxed); ++i) {
+                for (std::size_t j = i + 1; j < n; ++j) {
+                    const auto ns = measure_round_trip(cpus[i], cpus[j], abort.flag);
+                    if (abort.flag.load(std::memory_order_relaxed))
+                        break;
+                    if (!ns) {
+                        error = ns.error();
+                        abort.flag.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                    result.round_trip_ns[i][j] = *ns;
+                    result.round_trip_ns[j][i] = *ns;
+                    done.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            finished.store(true, std::memory_order_release);
+        });
+
+        while (!finished.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(milliseconds(50));
+            if (g_interrupted || stop.stop_requested())
+                abort.flag.store(true, std::memory_order_relaxed);
+            if (progress_cb)
+                progress_cb(done.load(std::memory_order_relaxed), total, " Core-to-Core");
+        }
+    }
+
+    if (!error.empty())
+        return std::unexpected(error);
+    if (abort.flag.load() || g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+
+    group_domains(result);
+    return result;
+}
@@ -8,35 +8,53 @@
 #include "include/disk_benchmark.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <barrier>
 #include <cerrno>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <format>
+#include <fstream>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <new>
 #include <numeric>
+#include <optional>
 #include <print>
+#include <random>
 #include <ranges>
 #include <span>
 #include <stdexcept>
 #include <stop_token>
 #include <system_error>
+#include <thread>
 
+#include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/statvfs.h>
+#include <sys/sysmacros.h>
+#include <sys/uio.h>
 
 #include <fcntl.h>
+#include <linux/fs.h>
 #include <unistd.h>
 
+#include "include/affinity.hpp"
 #include "include/color.hpp"
 #include "include/config.hpp"
 #include "include/file_descriptor.hpp"
 #include "include/interrupts.hpp"
+#include "include/latency_histogram.hpp"
+#include "include/memory_region.hpp"
+#include "include/payload_generator.hpp"
 #include "include/results.hpp"
 #include "include/system_info.hpp"
 #include "include/utils.hpp"
@@ -49,13 +67,49 @@ using namespace std::chrono;
 
 namespace {
 
-struct AlignedDelete {
-    std::size_t alignment;
+// Single-number sysfs attribute such as queue/logical_block_size; nullopt if unreadable.
+std::optional<std::uint64_t> read_sysfs_number(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::uint64_t value = 0;
+    if (!(file >> value))
+        return std::nullopt;
+    return value;
+}
 
-    void operator()(void* ptr) const noexcept {
-        ::operator delete(ptr, std::align_val_t(alignment));
-    }
-};
+// Block-layer view of one phase. `write` selects which half of the counters to use; the
+// utilization and queue figures cover both directions, as iostat's do.
+DiskKernelStats kernel_stats_delta(const std::string& device,
+                                   const DiskStatSnapshot& before,
+                                   const DiskStatSnapshot& after,
+                                   bool write,
+                                   duration<double> elapsed,
+                                   std::size_t submitted_block) {
+    const auto ios = write ? after.writes - before.writes : after.reads - before.reads;
+    const auto merged = write ? after.writes_merged - before.writes_merged
+                              : after.reads_merged - before.reads_merged;
+    const auto sectors = write ? after.sectors_written - before.sectors_written
+                               : after.sectors_read - before.sectors_read;
+    const double elapsed_ms = elapsed.count() * 1000.0;
+
+    DiskKernelStats stats;
+    stats.device = device;
+    stats.submitted_kib = static_cast<double>(submitted_block) / 1024.0;
+    if (elapsed_ms <= 0)
+        return stats;
+
+    const auto requests = static_cast<double>(ios);
+    const auto merges = static_cast<double>(merged);
+    stats.iops = requests / elapsed.count();
+    if (ios + merged > 0)
+        stats.merge_percent = merges / (requests + merges) * 100.0;
+    if (ios > 0)
+        stats.request_kib = static_cast<double>(sectors) * 512.0 / 1024.0 / requests;
+    stats.avg_queue =
+        static_cast<double>(after.queue_ticks_ms - before.queue_ticks_ms) / elapsed_ms;
+    stats.util_percent = std::min(
+        100.0, static_cast<double>(after.io_ticks_ms - before.io_ticks_ms) / elapsed_ms * 100.0);
+    return stats;
+}
 
 struct FileCleaner {
     std::filesystem::path path;
@@ -68,29 +122,24 @@ struct FileCleaner {
     }
 };
 
-void optimize_memory_region(std::span<std::byte> mem) noexcept {
-    if (mem.empty())
-        return;
-
-    void* ptr = mem.data();
-    size_t size = mem.size_bytes();
+struct DirectoryCleaner {
+    std::filesystem::path path;
 
-    ::madvise(ptr, size, MADV_HUGEPAGE);
-}
+    ~DirectoryCleaner() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
 
-[[nodiscard]] std::expected<std::unique_ptr<std::byte[], AlignedDelete>, std::string>
-make_aligned_buffer(std::size_t size, std::size_t alignment) {
-    void* ptr = ::operator new(size, std::align_val_t(alignment), std::nothrow);
+void fill_pattern(std::span<std::byte> mem) noexcept {
+    constexpr unsigned int RNG_MULTIPLIER = 0x9E3779B1u;
 
-    if (!ptr) [[unlikely]] {
-        return std::unexpected(
-            std::format("FATAL: Failed to allocate {} bytes (aligned to {}). System Out of Memory.",
-                        size,
-                        alignment));
-    }
+    auto pattern_gen = [=](size_t idx) {
+        return std::byte{static_cast<unsigned char>(idx * RNG_MULTIPLIER)};
+    };
 
-    return std::unique_ptr<std::byte[], AlignedDelete>(static_cast<std::byte*>(ptr),
-                                                       AlignedDelete{alignment});
+    std::ranges::copy(
+        std::views::iota(size_t{0}, mem.size()) | std::views::transform(pattern_gen), mem.begin());
 }
 
 [[nodiscard]] std::string get_error_message(int err, std::string_view operation) {
@@ -101,6 +150,9 @@ make_aligned_buffer(std::size_t size, std::size_t alignment) {
             return "User disk quota exceeded";
         case EIO:
             return "Critical I/O error (Hardware failure suspected)";
+        case EINTR:
+            // Callers retry EINTR until the user asks to stop, so this is always Ctrl+C.
+            return "Operation interrupted by user";
         case EROFS:
             return "File system is Read-Only";
         case EACCES:
@@ -121,51 +173,294 @@ make_aligned_buffer(std::size_t size, std::size_t alignment) {
     }
 }
 
+struct XorShift64 {
+    std::uint64_t state;
+
+    std::uint64_t next() noexcept {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+[[nodiscard]] double median_of(std::span<const double> values) {
+    if (values.empty())
+        return 0.0;
+
+    std::vector<double> sorted(values.begin(), values.end());
+    auto mid = sorted.begin() + static_cast<std::ptrdiff_t>(sorted.size() / 2);
+    std::ranges::nth_element(sorted, mid);
+    return *mid;
+}
+
+// Splits a throughput series into burst and sustained rates. The burst rate is the
+// median of the opening tenth, the sustained rate the median of the closing third; a
+// cliff is reported when sustained falls below IO_STEADY_CLIFF_RATIO of burst, at the
+// last point where the one-second rolling mean was still above their midpoint.
+void analyze_series(DiskSteadyStatePhaseResult& phase) {
+    const std::span<const double> series = phase.series_mbps;
+    if (series.empty())
+        return;
+
+    const std::size_t n = series.size();
+    const std::size_t head = std::max<std::size_t>(1, n / 10);
+    const std::size_t tail = std::max<std::size_t>(1, n / 3);
+
+    phase.mean_mbps = std::accumulate(series.begin(), series.end(), 0.0) / static_cast<double>(n);
+    phase.burst_mbps = median_of(series.first(head));
+    phase.steady_mbps = median_of(series.last(tail));
+
+    if (phase.burst_mbps <= 0 ||
+        phase.steady_mbps >= phase.burst_mbps * Config::IO_STEADY_CLIFF_RATIO) {
+        return;
+    }
+
+    const double threshold = (phase.burst_mbps + phase.steady_mbps) / 2.0;
+    const auto window = static_cast<std::size_t>(
+        std::max(1.0, 1000.0 / static_cast<double>(Config::IO_STEADY_SAMPLE_MS)));
+
+    double rolling = 0.0;
+    std::size_t last_above = 0;
+    bool seen_above = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        rolling += series[i];
+        if (i >= window)
+            rolling -= series[i - window];
+        const double mean = rolling / static_cast<double>(std::min(i + 1, window));
+        if (mean >= threshold) {
+            last_above = i;
+            seen_above = true;
+        }
+    }
+
+    if (seen_above) {
+        phase.cliff_seconds = static_cast<double>(last_above + 1) * phase.sample_interval_ms /
+                              1000.0;
+    }
+}
+
 #ifdef USE_IO_URING
 
+#ifndef IORING_SETUP_COOP_TASKRUN
+#define IORING_SETUP_COOP_TASKRUN (1U << 8)
+#endif
+#ifndef IORING_SETUP_SINGLE_ISSUER
+#define IORING_SETUP_SINGLE_ISSUER (1U << 12)
+#endif
+
+struct RingGuard {
+    io_uring& ring;
+
+    ~RingGuard() {
+        io_uring_queue_exit(&ring);
+    }
+};
+
+// Buffers and the fd the ring knows about. Indices are -1 when that resource could not
+// be registered and the pass has to fall back to plain read/write.
+struct UringRegistration {
+    int write_buf_index = -1;
+    int read_buf_index = -1;
+    bool fixed_file = false;
+};
+
+[[nodiscard]] std::string describe_uring_path(unsigned setup_flags, const UringRegistration& reg) {
+    std::string modes;
+    constexpr std::array<std::pair<unsigned, std::string_view>, 4> names = {
+        {{IORING_SETUP_SQPOLL, "SQPOLL"},
+         {IORING_SETUP_IOPOLL, "IOPOLL"},
+         {IORING_SETUP_COOP_TASKRUN, "COOP_TASKRUN"},
+         {IORING_SETUP_SINGLE_ISSUER, "SINGLE_ISSUER"}}};
+    for (const auto& [flag, name] : names) {
+        if (setup_flags & flag) {
+            modes += modes.empty() ? "" : ", ";
+            modes += name;
+        }
+    }
+
+    const bool fixed_buffers = reg.write_buf_index >= 0 || reg.read_buf_index >= 0;
+    std::string_view registered = "unregistered";
+    if (fixed_buffers && reg.fixed_file)
+        registered = "registered buffers + file";
+    else if (fixed_buffers)
+        registered = "registered buffers";
+    else if (reg.fixed_file)
+        registered = "registered file";
+
+    if (modes.empty())
+        return std::format("io_uring ({})", registered);
+    return std::format("io_uring [{}] ({})", modes, registered);
+}
+
+// Pins the buffers and the benchmark fd in the ring so the kernel skips per-request
+// page pinning and fd lookup. Failures (e.g. RLIMIT_MEMLOCK on pre-5.12 kernels) are
+// not fatal; the returned registration just reports what is available.
+[[nodiscard]] UringRegistration register_uring_resources(io_uring& ring,
+                                                         int fd,
+                                                         std::span<std::byte> write_buffer,
+                                                         std::span<std::byte> read_pool) {
+    UringRegistration reg;
+    if constexpr (!Config::IO_URING_REGISTER_RESOURCES) {
+        return reg;
+    }
+
+    std::array<iovec, 2> iovs{};
+    unsigned count = 0;
+    int write_index = -1;
+    int read_index = -1;
+    if (!write_buffer.empty()) {
+        iovs[count] = iovec{write_buffer.data(), write_buffer.size()};
+        write_index = static_cast<int>(count++);
+    }
+    if (!read_pool.empty()) {
+        iovs[count] = iovec{read_pool.data(), read_pool.size()};
+        read_index = static_cast<int>(count++);
+    }
+
+    if (count > 0 && io_uring_register_buffers(&ring, iovs.data(), count) == 0) {
+        reg.write_buf_index = write_index;
+        reg.read_buf_index = read_index;
+    }
+
+    reg.fixed_file = io_uring_register_files(&ring, &fd, 1) == 0;
+    return reg;
+}
+
+// Mean and 95% confidence half-width of per-interval throughput in bytes/s. Uses the
+// normal approximation; adjacent intervals are somewhat correlated, which the interval
+// length (Config::IO_CONVERGE_SAMPLE_MS) is long enough to keep small.
+struct IntervalConfidence {
+    double mean = 0.0;
+    double half_width = 0.0;
+    std::size_t samples = 0;
+};
+
+[[nodiscard]] IntervalConfidence interval_confidence(std::span<const std::uint64_t> bytes,
+                                                     nanoseconds interval) {
+    IntervalConfidence ci;
+    ci.samples = bytes.size();
+    if (ci.samples < 2)
+        return ci;
+
+    const double secs = duration<double>(interval).count();
+    const auto n = static_cast<double>(ci.samples);
+    double sum = 0.0;
+    for (std::uint64_t b : bytes)
+        sum += static_cast<double>(b) / secs;
+    ci.mean = sum / n;
+
+    double squares = 0.0;
+    for (std::uint64_t b : bytes) {
+        const double d = static_cast<double>(b) / secs - ci.mean;
+        squares += d * d;
+    }
+    ci.half_width = 1.96 * std::sqrt(squares / (n - 1.0)) / std::sqrt(n);
+    return ci;
+}
+
+// One pass over a file region. Sequential passes walk the region once in block_size
+// steps (or lap it repeatedly with wrap_offsets); random passes pick block-aligned
+// offsets until total_ops or soft_deadline.
+struct UringPass {
+    int fd = -1;
+    std::uint64_t total_ops = 0;
+    std::uint64_t span_bytes = 0;
+    std::uint64_t base_offset = 0;  // start of the region within the file
+    std::size_t block_size = 0;
+    bool random_offsets = false;
+    bool wrap_offsets = false;
+    int read_percent = 0;
+    int queue_depth = 1;
+    std::span<std::byte> write_buffer;
+    std::span<std::byte> read_pool;
+    high_resolution_clock::time_point deadline;
+    high_resolution_clock::time_point soft_deadline = high_resolution_clock::time_point::max();
+    LatencyHistogram* histogram = nullptr;
+    // When set, every write gets fresh payload in its own block_size slot of write_buffer.
+    // Writes are stamped with sequence, plus the lap number on wrapped passes, so a rewrite
+    // never carries the same bytes as the prefill it replaces.
+    const PayloadGenerator* payload = nullptr;
+    std::uint64_t sequence = 0;
+    // When set, every read is checked against this generator as it is reaped.
+    const PayloadGenerator* verify = nullptr;
+    UringRegistration registration;
+    // Completed bytes per sample_interval since the pass started; preallocated by caller.
+    std::span<std::uint64_t> interval_bytes;
+    nanoseconds sample_interval{0};
+    // > 0 (with interval_bytes): stop submitting once the closed intervals' 95% CI is within
+    // this fraction of their mean and converge_after has passed.
+    double converge_tolerance = 0.0;
+    nanoseconds converge_after{0};
+};
+
+struct UringPassStats {
+    std::uint64_t completed = 0;
+    std::uint64_t bytes = 0;
+    duration<double> elapsed{};
+    bool converged = false;
+};
+
 [[nodiscard]] std::string uring_error(int rc, std::string_view op) {
     int err = -rc;
     return std::format("io_uring {} failed: {}", op, std::system_category().message(err));
 }
 
-[[nodiscard]] std::expected<void, std::string> run_uring_io(
-    bool is_write,
+[[nodiscard]] std::expected<UringPassStats, std::string> run_uring_io(
     io_uring& ring,
-    int fd,
-    std::uint64_t total_blocks,
-    std::uint64_t total_bytes,
-    std::size_t block_size,
-    std::span<std::byte> write_buffer,
-    std::span<const std::unique_ptr<std::byte[], AlignedDelete>> read_buffers,
-    int queue_depth,
-    high_resolution_clock::time_point deadline,
+    const UringPass& pass,
     const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
     std::string_view label,
     std::stop_token stop) {
-    static_assert(Config::IO_READ_QUEUE_DEPTH <= (1ULL << 32),
+    static_assert(std::max({Config::IO_READ_QUEUE_DEPTH,
+                            Config::IO_RANDOM_QUEUE_DEPTH,
+                            std::ranges::max(Config::IO_SWEEP_QUEUE_DEPTHS)}) <= (1LL << 31),
                   "Queue depth config exceeds 32-bit limit for io_uring user_data encoding");
 
-    std::uint64_t submitted = 0;
-    std::uint64_t completed = 0;
-    bool interrupt_requested = false;
+    const bool time_limited = pass.soft_deadline != high_resolution_clock::time_point::max();
+    const auto queue_depth = static_cast<std::size_t>(std::max(1, pass.queue_depth));
+    const std::uint64_t span_blocks = std::max<std::uint64_t>(1, pass.span_bytes / pass.block_size);
 
-    std::vector<std::size_t> free_read_indices;
-    if (!is_write) {
-        free_read_indices.reserve(read_buffers.size());
-        for (std::size_t i = 0; i < read_buffers.size(); ++i) {
-            free_read_indices.push_back(i);
-        }
+    if (pass.read_percent > 0 && pass.read_pool.size() < queue_depth * pass.block_size) {
+        return std::unexpected("Read buffer pool smaller than queue depth");
     }
 
-    while (completed < total_blocks) {
-        while (submitted < total_blocks &&
-               (submitted - completed) < static_cast<std::uint64_t>(queue_depth)) {
+    // Every in-flight request owns a slot; the slot index travels in user_data so the
+    // completion can find its buffer, direction and submit timestamp.
+    std::vector<std::size_t> free_slots(queue_depth);
+    std::iota(free_slots.rbegin(), free_slots.rend(), std::size_t{0});
+    std::vector<high_resolution_clock::time_point> slot_started(queue_depth);
+    std::vector<char> slot_is_write(queue_depth, 0);
+    std::vector<std::uint64_t> slot_offset(queue_depth, 0);
+
+    const UringRegistration& reg = pass.registration;
+    const int target_fd = reg.fixed_file ? 0 : pass.fd;
+
+    // Fresh per pass: a fixed seed would replay the same offsets in every phase and let
+    // the device or host cache serve the repeats.
+    std::random_device rd;
+    XorShift64 rng{(std::uint64_t{rd()} << 32) | rd() | 1};  // xorshift state must be non-zero
+
+    UringPassStats stats;
+    std::uint64_t submitted = 0;
+    bool interrupt_requested = false;
+    bool timed_out = false;
+    bool soft_stop = false;
+    const auto start = high_resolution_clock::now();
+
+    const std::size_t progress_total =
+        time_limited ? static_cast<std::size_t>(
+                           duration_cast<milliseconds>(pass.soft_deadline - start).count())
+                     : static_cast<std::size_t>(pass.total_ops);
+    const std::size_t progress_step = std::max<std::size_t>(1, progress_total / 200);
+    std::size_t progress_reported = 0;
+    std::size_t intervals_checked = 0;
+
+    while (stats.completed < submitted || (!soft_stop && submitted < pass.total_ops)) {
+        while (!soft_stop && submitted < pass.total_ops && !free_slots.empty()) {
             if (g_interrupted || stop.stop_requested() || interrupt_requested) {
                 interrupt_requested = true;
-                break;
-            }
-
-            if (!is_write && free_read_indices.empty()) {
+                soft_stop = true;
                 break;
             }
 
@@ -173,35 +468,77 @@ make_aligned_buffer(std::size_t size, std::size_t alignment) {
             if (!sqe)
                 break;
 
-            std::uint64_t offset_bytes = submitted * static_cast<std::uint64_t>(block_size);
-            std::uint64_t remaining = total_bytes - offset_bytes;
-            std::size_t chunk =
-                static_cast<std::size_t>(std::min<std::uint64_t>(remaining, block_size));
+            std::uint64_t offset_bytes = 0;
+            std::size_t chunk = pass.block_size;
+            if (pass.random_offsets) {
+                offset_bytes = (rng.next() % span_blocks) * pass.block_size;
+            } else if (pass.wrap_offsets) {
+                offset_bytes = (submitted % span_blocks) * pass.block_size;
+            } else {
+                offset_bytes = submitted * static_cast<std::uint64_t>(pass.block_size);
+                std::uint64_t remaining = pass.span_bytes - offset_bytes;
+                chunk = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(remaining, pass.block_size));
+            }
+            offset_bytes += pass.base_offset;
             unsigned int len = static_cast<unsigned int>(chunk);
 
+            bool is_write = pass.read_percent <= 0 ||
+                            (pass.read_percent < 100 &&
+                             static_cast<int>(rng.next() % 100) >= pass.read_percent);
+
+            std::size_t slot = free_slots.back();
+            free_slots.pop_back();
+
             if (is_write) {
-                if (chunk > write_buffer.size()) {
+                std::byte* src = pass.write_buffer.data();
+                if (pass.payload) {
+                    if ((slot + 1) * pass.block_size > pass.write_buffer.size()) {
+                        return std::unexpected("Write buffer pool smaller than queue depth");
+                    }
+                    src += slot * pass.block_size;
+                    const std::uint64_t lap =
+                        pass.sequence + (pass.wrap_offsets ? submitted / span_blocks : 0);
+                    pass.payload->fill(std::span{src, chunk}, offset_bytes, lap);
+                } else if (chunk > pass.write_buffer.size()) {
                     return std::unexpected("Buffer overflow detected in write preparation");
                 }
-                io_uring_prep_write(sqe, fd, write_buffer.data(), len, offset_bytes);
-                io_uring_sqe_set_data64(sqe, static_cast<__u64>(len));
+                if (reg.write_buf_index >= 0) {
+                    io_uring_prep_write_fixed(
+                        sqe, target_fd, src, len, offset_bytes, reg.write_buf_index);
+                } else {
+                    io_uring_prep_write(sqe, target_fd, src, len, offset_bytes);
+                }
             } else {
-                size_t buf_idx = free_read_indices.back();
-                free_read_indices.pop_back();
-
-                if (buf_idx >= read_buffers.size()) {
-                    return std::unexpected("Read buffer index out of range");
+                if (chunk > pass.block_size) {
+                    return std::unexpected("Buffer overflow detected in read preparation");
                 }
-                io_uring_prep_read(sqe, fd, read_buffers[buf_idx].get(), len, offset_bytes);
+                std::byte* dest = pass.read_pool.data() + slot * pass.block_size;
+                if (reg.read_buf_index >= 0) {
+                    io_uring_prep_read_fixed(
+                        sqe, target_fd, dest, len, offset_bytes, reg.read_buf_index);
+                } else {
+                    io_uring_prep_read(sqe, target_fd, dest, len, offset_bytes);
+                }
+            }
 
-                std::uint64_t user_data =
-                    (static_cast<std::uint64_t>(buf_idx) << 32) | static_cast<std::uint32_t>(len);
-                io_uring_sqe_set_data64(sqe, user_data);
+            if (reg.fixed_file) {
+                io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
             }
 
+            std::uint64_t user_data =
+                (static_cast<std::uint64_t>(slot) << 32) | static_cast<std::uint32_t>(len);
+            io_uring_sqe_set_data64(sqe, user_data);
+
+            slot_is_write[slot] = is_write ? 1 : 0;
+            slot_offset[slot] = offset_bytes;
+            slot_started[slot] = high_resolution_clock::now();
             submitted++;
         }
 
+        if (stats.completed >= submitted)
+            break;
+
         int submit_rc = io_uring_submit(&ring);
         if (submit_rc < 0) {
             return std::unexpected(uring_error(submit_rc, "submit"));
@@ -214,12 +551,14 @@ make_aligned_buffer(std::size_t size, std::size_t alignment) {
             if (wait_rc == -EINTR) {
                 if (g_interrupted || stop.stop_requested()) {
                     interrupt_requested = true;
+                    soft_stop = true;
                 }
                 continue;
             }
             return std::unexpected(uring_error(wait_rc, "wait"));
         }
 
+        const auto reaped_at = high_resolution_clock::now();
         unsigned head;
         unsigned count = 0;
 
@@ -227,21 +566,18 @@ make_aligned_buffer(std::size_t size, std::size_t alignment) {
             count++;
             std::uint64_t user_data = io_uring_cqe_get_data64(cqe);
             int expected_len = static_cast<int>(user_data & 0xFFFFFFFF);
-
-            if (!is_write) {
-                size_t buf_idx = static_cast<size_t>(user_data >> 32);
-                free_read_indices.push_back(buf_idx);
-            }
+            auto slot = static_cast<std::size_t>(user_data >> 32);
+            std::string_view op = slot_is_write[slot] ? "write" : "read";
+            free_slots.push_back(slot);
 
             if (cqe->res < 0) {
                 io_uring_cq_advance(&ring, count);
-                std::string op = is_write ? "write" : "read";
-                return std::unexpected("Disk Test failed: " + get_error_message(-cqe->res, op));
+                return std::unexpected("Disk Test failed: " +
+                                       get_error_message(-cqe->res, op));
             }
 
             if (cqe->res != expected_len) {
                 io_uring_cq_advance(&ring, count);
-                std::string op = is_write ? "write" : "read";
                 return std::unexpected(
                     std::format("Disk Test failed: Partial {} (expected {} bytes, got {})",
                                 op,
@@ -249,29 +585,174 @@ make_aligned_buffer(std::size_t size, std::size_t alignment) {
                                 cqe->res));
             }
 
-            ++completed;
-            if (progress_cb && completed % 2 == 0) {
-                progress_cb(static_cast<std::size_t>(completed),
-                            static_cast<std::size_t>(total_blocks),
-                            label);
+            if (pass.histogram) {
+                pass.histogram->record(static_cast<std::uint64_t>(
+                    duration_cast<nanoseconds>(reaped_at - slot_started[slot]).count()));
+            }
+
+            // Checked here, before the slot can be resubmitted, while the rest of the
+            // queue stays in flight.
+            if (pass.verify && !slot_is_write[slot]) {
+                const std::byte* data = pass.read_pool.data() + slot * pass.block_size;
+                auto verified = pass.verify->verify(
+                    std::span{data, static_cast<std::size_t>(expected_len)}, slot_offset[slot]);
+                if (!verified) {
+                    io_uring_cq_advance(&ring, count);
+                    return std::unexpected("Data verification failed: " + verified.error());
+                }
+            }
+
+            if (!pass.interval_bytes.empty()) {
+                auto sample = static_cast<std::size_t>((reaped_at - start) / pass.sample_interval);
+                if (sample < pass.interval_bytes.size())
+                    pass.interval_bytes[sample] += static_cast<std::uint64_t>(expected_len);
             }
+
+            stats.bytes += static_cast<std::uint64_t>(expected_len);
+            ++stats.completed;
         }
 
         io_uring_cq_advance(&ring, count);
 
-        if (interrupt_requested && completed >= submitted) {
-            return std::unexpected("Operation interrupted by user");
+        if (progress_cb) {
+            std::size_t progress_now =
+                time_limited
+                    ? static_cast<std::size_t>(
+                          duration_cast<milliseconds>(reaped_at - start).count())
+                    : static_cast<std::size_t>(stats.completed);
+            if (progress_now >= progress_reported + progress_step) {
+                progress_reported = progress_now;
+                progress_cb(std::min(progress_now, progress_total), progress_total, label);
+            }
+        }
+
+        if (time_limited && reaped_at >= pass.soft_deadline) {
+            soft_stop = true;
         }
 
-        if (high_resolution_clock::now() > deadline) {
-            interrupt_requested = true;
-            if (completed >= submitted) {
-                return std::unexpected("Disk Test timed out (operation took too long)");
+        if (pass.converge_tolerance > 0 && !pass.interval_bytes.empty() && !soft_stop &&
+            reaped_at - start >= pass.converge_after) {
+            const auto closed = std::min(
+                pass.interval_bytes.size(),
+                static_cast<std::size_t>((reaped_at - start) / pass.sample_interval));
+            if (closed != intervals_checked && closed >= Config::IO_CONVERGE_MIN_SAMPLES) {
+                intervals_checked = closed;
+                auto ci = interval_confidence(pass.interval_bytes.first(closed),
+                                              pass.sample_interval);
+                if (ci.mean > 0 && ci.half_width <= pass.converge_tolerance * ci.mean) {
+                    stats.converged = true;
+                    soft_stop = true;
+                }
             }
         }
+
+        if (reaped_at > pass.deadline) {
+            timed_out = true;
+            soft_stop = true;
+        }
     }
 
-    return {};
+    if (timed_out) {
+        return std::unexpected("Disk Test timed out (operation took too long)");
+    }
+
+    if (interrupt_requested) {
+        return std::unexpected("Operation interrupted by user");
+    }
+
+    stats.elapsed = high_resolution_clock::now() - start;
+    return stats;
+}
+
+// IOPOLL is accepted at setup time on any kernel that knows the flag, but requests to a
+// file or device without poll support fail at completion. Push one request through before
+// trusting the ring: a small read, or on a write-only fd a zero-length write, which is
+// checked for poll support like any other but leaves the file untouched.
+[[nodiscard]] bool iopoll_usable(io_uring& ring, int fd, std::span<std::byte> probe_buf) {
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+    if (!sqe)
+        return false;
+
+    const int access = ::fcntl(fd, F_GETFL) & O_ACCMODE;
+    if (access == O_WRONLY) {
+        io_uring_prep_write(sqe, fd, probe_buf.data(), 0, 0);
+    } else {
+        const auto len = static_cast<unsigned>(std::min(probe_buf.size(), Config::IO_ALIGNMENT));
+        io_uring_prep_read(sqe, fd, probe_buf.data(), len, 0);
+    }
+
+    if (io_uring_submit(&ring) < 0)
+        return false;
+
+    io_uring_cqe* cqe = nullptr;
+    if (io_uring_wait_cqe(&ring, &cqe) < 0)
+        return false;
+
+    const bool ok = cqe->res >= 0;
+    io_uring_cqe_seen(&ring, cqe);
+    return ok;
+}
+
+// Sets up a ring with the requested polling modes, dropping whatever the kernel or the
+// target refuses: first the COOP_TASKRUN/SINGLE_ISSUER hints, then IOPOLL, then SQPOLL.
+// The hints only go on polled rings, so the default ring stays the plain baseline the
+// SQPOLL/IOPOLL results are compared against. Returns the setup flags in effect.
+[[nodiscard]] std::expected<unsigned, std::string> open_ring(io_uring& ring,
+                                                             unsigned entries,
+                                                             const DiskTestOptions& options,
+                                                             int probe_fd,
+                                                             std::span<std::byte> probe_buf) {
+    unsigned wanted = 0;
+    if (options.sqpoll) {
+        wanted |= IORING_SETUP_SQPOLL;
+        if (options.sqpoll_cpu >= 0)
+            wanted |= IORING_SETUP_SQ_AFF;
+    }
+    if (options.iopoll) {
+        wanted |= IORING_SETUP_IOPOLL;
+    }
+
+    // Task-work IPIs do not exist with an SQ thread, so COOP_TASKRUN is rejected there.
+    auto with_hints = [](unsigned flags) {
+        return flags | IORING_SETUP_SINGLE_ISSUER |
+               ((flags & IORING_SETUP_SQPOLL) ? 0U : IORING_SETUP_COOP_TASKRUN);
+    };
+
+    const std::array<unsigned, 4> modes = {
+        wanted,
+        wanted & ~IORING_SETUP_IOPOLL,
+        wanted & ~(IORING_SETUP_SQPOLL | IORING_SETUP_SQ_AFF),
+        0U,
+    };
+
+    int ret = -EINVAL;
+    for (unsigned mode : modes) {
+        const std::array<unsigned, 2> attempts = {with_hints(mode), mode};
+        for (unsigned flags : std::span(attempts).subspan(wanted == 0 ? 1 : 0)) {
+            io_uring_params params{};
+            params.flags = flags;
+            if (flags & IORING_SETUP_SQPOLL) {
+                params.sq_thread_idle = Config::IO_SQPOLL_IDLE_MS;
+                params.sq_thread_cpu = static_cast<unsigned>(std::max(0, options.sqpoll_cpu));
+            }
+
+            ret = io_uring_queue_init_params(entries, &ring, &params);
+            if (ret != 0)
+                continue;
+
+            if ((flags & IORING_SETUP_IOPOLL) &&
+                !iopoll_usable(ring, probe_fd, probe_buf)) {
+                io_uring_queue_exit(&ring);
+                ret = -EOPNOTSUPP;
+                break;
+            }
+            return flags;
+        }
+    }
+
+    return std::unexpected(
+        std::format("Skipped: io_uring feature not available (Kernel <= 5.4?). Error: {}",
+                    std::system_category().message(-ret)));
 }
 
 #endif
@@ -332,6 +813,9 @@ void print_storage_warning(int mode, bool is_read) {
             return;
     }
 
+    // The multi-path test opens files from one thread per disk group.
+    static std::mutex warning_mutex;
+    std::scoped_lock lock(warning_mutex);
     std::print(stderr,
                "{}Warning: {}. Benchmark {} results may be influenced by RAM cache.{}\n",
                Color::YELLOW,
@@ -340,128 +824,940 @@ void print_storage_warning(int mode, bool is_read) {
                Color::RESET);
 }
 
-}  // namespace
+#ifdef USE_IO_URING
 
-std::expected<DiskIORunResult, std::string> DiskBenchmark::run_io_test(
-    int size_mb,
-    std::string_view label,
+// Creates the scratch file, preallocates it and lays down real data so that later
+// reads hit allocated extents rather than holes (or deduplicated blocks). The fill runs
+// on its own plain ring so the measured ring can use polling modes that need the file to
+// exist. The page cache copy is dropped before returning.
+[[nodiscard]] std::expected<FileDescriptor, std::string> prepare_test_file(
+    const std::string& filename,
+    std::uint64_t total_bytes,
+    const PayloadGenerator& payload,
     const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::string_view label,
     std::stop_token stop) {
-    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
-    FileCleaner cleaner{filename};
+    std::error_code ec;
+    std::filesystem::remove(filename, ec);
 
-    const size_t write_block_size = Config::IO_WRITE_BLOCK_SIZE;
-    const size_t read_block_size = Config::IO_READ_BLOCK_SIZE;
-    const int queue_depth_write = std::max(1, Config::IO_WRITE_QUEUE_DEPTH);
-    const int queue_depth_read = std::max(1, Config::IO_READ_QUEUE_DEPTH);
-
-    auto current_path = std::filesystem::current_path();
-    std::uint64_t required = static_cast<std::uint64_t>(size_mb) * 1024 * 1024;
+#ifndef O_DIRECT
+    return std::unexpected("FATAL: O_DIRECT is not available on this platform compilation.");
+#endif
 
-    if (!is_disk_space_available(current_path, required)) {
-        return std::unexpected("Insufficient free space for disk test (needs " +
-                               format_bytes(required) + ")");
+    auto [fd, success_mode] =
+        open_benchmark_file(filename, O_RDWR | O_CREAT | O_TRUNC | O_EXCL, 0600);
+    if (!fd) {
+        return std::unexpected(get_error_message(errno, "create"));
     }
 
-    auto buffer_res = make_aligned_buffer(write_block_size, Config::IO_ALIGNMENT);
-    if (!buffer_res) {
-        return std::unexpected(buffer_res.error());
+    print_storage_warning(success_mode, false);
+
+    int prealloc_rc = ::posix_fallocate(fd.get(), 0, static_cast<off_t>(total_bytes));
+    if (prealloc_rc != 0 && prealloc_rc != EINVAL && prealloc_rc != ENOTSUP) {
+        return std::unexpected(
+            std::format("Preallocation failed: {}", std::system_category().message(prealloc_rc)));
     }
-    auto buffer = std::move(buffer_res.value());
 
-    constexpr unsigned int RNG_MULTIPLIER = 0x9E3779B1u;
+    io_uring ring{};
+    int ret = io_uring_queue_init(static_cast<unsigned>(Config::IO_WRITE_QUEUE_DEPTH), &ring, 0);
+    if (ret != 0) {
+        return std::unexpected(
+            std::format("Skipped: io_uring feature not available (Kernel <= 5.4?). Error: {}",
+                        std::system_category().message(-ret)));
+    }
+    RingGuard ring_guard{ring};
+
+    const std::size_t block_size = Config::IO_WRITE_BLOCK_SIZE;
+    const std::size_t pool_size =
+        static_cast<std::size_t>(Config::IO_WRITE_QUEUE_DEPTH) * block_size;
+    auto pool_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+    if (!pool_res) {
+        return std::unexpected(pool_res.error());
+    }
+    auto pool = std::move(pool_res.value());
+
+    UringPass fill;
+    fill.fd = fd.get();
+    fill.total_ops = (total_bytes + block_size - 1) / block_size;
+    fill.span_bytes = total_bytes;
+    fill.block_size = block_size;
+    fill.queue_depth = Config::IO_WRITE_QUEUE_DEPTH;
+    fill.write_buffer = std::span{pool.get(), pool_size};
+    fill.payload = &payload;
+    // The usual time limit is sized for the 1 GiB test; large working sets get it per GiB.
+    const auto gib = std::max<std::uint64_t>(1, total_bytes >> 30);
+    fill.deadline = high_resolution_clock::now() +
+                    seconds(Config::DISK_BENCHMARK_MAX_SECONDS) * static_cast<long>(gib);
+
+    auto res = run_uring_io(ring, fill, progress_cb, label, stop);
+    if (!res)
+        return std::unexpected(res.error());
 
-    auto pattern_gen = [=](size_t idx) {
-        return std::byte{static_cast<unsigned char>(idx * RNG_MULTIPLIER)};
-    };
+    if (::fdatasync(fd.get()) == -1) {
+        return std::unexpected("Disk sync failed: " + get_error_message(errno, "sync"));
+    }
+    ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
 
-    auto write_mem = std::span{buffer.get(), write_block_size};
-    optimize_memory_region(write_mem);
+    return std::move(fd);
+}
 
-    std::ranges::copy(
-        std::views::iota(size_t{0}, write_block_size) | std::views::transform(pattern_gen),
-        write_mem.begin());
+#endif
 
-    std::vector<std::unique_ptr<std::byte[], AlignedDelete>> read_buffers;
-    read_buffers.reserve(static_cast<size_t>(queue_depth_read));
-    for (int k = 0; k < queue_depth_read; ++k) {
-        auto read_buf_res = make_aligned_buffer(read_block_size, Config::IO_ALIGNMENT);
-        if (!read_buf_res) {
-            return std::unexpected(read_buf_res.error());
-        }
-        read_buffers.push_back(std::move(read_buf_res.value()));
+struct MappedRegion {
+    void* addr = MAP_FAILED;
+    std::size_t length = 0;
 
-        auto read_mem = std::span{read_buffers.back().get(), read_block_size};
-        optimize_memory_region(read_mem);
+    ~MappedRegion() {
+        if (addr != MAP_FAILED)
+            ::munmap(addr, length);
+    }
+};
 
-        std::ranges::copy(
-            std::views::iota(size_t{0}, read_block_size) | std::views::transform(pattern_gen),
-            read_mem.begin());
+// Reports progress for engines that loop on their own rather than through run_uring_io.
+struct BlockProgress {
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb;
+    std::string_view label;
+    std::size_t total;
+    std::size_t step = std::max<std::size_t>(1, total / 200);
+    std::size_t reported = 0;
+
+    void update(std::size_t done) {
+        if (progress_cb && done >= reported + step) {
+            reported = done;
+            progress_cb(done, total, label);
+        }
     }
+};
 
-    auto start = high_resolution_clock::now();
-    auto deadline = start + std::chrono::seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
-    const std::uint64_t total_bytes = static_cast<std::uint64_t>(size_mb) * 1024 * 1024;
-    const std::uint64_t total_write_blocks =
-        (total_bytes + write_block_size - 1) / write_block_size;
-    const std::uint64_t total_read_blocks = (total_bytes + read_block_size - 1) / read_block_size;
+// Plain pread/pwrite loop over the file, one buffer-sized request at a time.
+[[nodiscard]] std::expected<std::uint64_t, std::string> run_psync_io(
+    int fd,
+    std::uint64_t total_bytes,
+    bool write,
+    std::span<std::byte> buffer,
+    const PayloadGenerator& payload,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::string_view label,
+    std::stop_token stop) {
+    const std::string_view op = write ? "write" : "read";
+    BlockProgress progress{progress_cb, label, static_cast<std::size_t>(
+                                                   (total_bytes + buffer.size() - 1) /
+                                                   buffer.size())};
+
+    std::uint64_t offset = 0;
+    while (offset < total_bytes) {
+        if (g_interrupted || stop.stop_requested()) {
+            return std::unexpected("Operation interrupted by user");
+        }
 
-    {
-        const std::string write_label = std::string(label) + " Write";
+        const auto chunk =
+            static_cast<std::size_t>(std::min<std::uint64_t>(total_bytes - offset, buffer.size()));
+        const auto pos = static_cast<off_t>(offset);
+        if (write)
+            payload.fill(buffer.first(chunk), offset);
+        ssize_t n = write ? ::pwrite(fd, buffer.data(), chunk, pos)
+                          : ::pread(fd, buffer.data(), chunk, pos);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return std::unexpected("Disk Test failed: " + get_error_message(errno, op));
+        }
+        if (n == 0) {
+            return std::unexpected(std::format("Disk Test failed: Unexpected end of file at {}",
+                                               format_bytes(offset)));
+        }
 
-        std::error_code ec;
-        std::filesystem::remove(filename, ec);
+        offset += static_cast<std::uint64_t>(n);
+        progress.update(static_cast<std::size_t>(offset / buffer.size()));
+    }
+    return offset;
+}
 
-        const int base_flags = O_WRONLY | O_CREAT | O_TRUNC | O_EXCL;
+// Maps the whole file shared and streams through it: writes generate payload straight
+// into the mapping and msync, reads touch every word. MADV_SEQUENTIAL lets the kernel
+// read ahead aggressively and drop pages behind the scan.
+[[nodiscard]] std::expected<std::uint64_t, std::string> run_mmap_io(
+    int fd,
+    std::uint64_t total_bytes,
+    bool write,
+    std::size_t chunk,
+    const PayloadGenerator& payload,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::string_view label,
+    std::stop_token stop) {
+    MappedRegion region;
+    region.length = static_cast<std::size_t>(total_bytes);
+    region.addr = ::mmap(nullptr,
+                         region.length,
+                         write ? PROT_READ | PROT_WRITE : PROT_READ,
+                         MAP_SHARED,
+                         fd,
+                         0);
+    if (region.addr == MAP_FAILED) {
+        return std::unexpected("Disk Test failed: " + get_error_message(errno, "mmap"));
+    }
+    ::madvise(region.addr, region.length, MADV_SEQUENTIAL);
 
-#ifndef O_DIRECT
-        return std::unexpected("FATAL: O_DIRECT is not available on this platform compilation.");
-#endif
+    auto* base = static_cast<std::byte*>(region.addr);
+    BlockProgress progress{progress_cb, label, (region.length + chunk - 1) / chunk};
+    std::uint64_t checksum = 0;
 
-        auto [fd, success_mode] = open_benchmark_file(filename, base_flags, 0600);
+    for (std::size_t offset = 0; offset < region.length; offset += chunk) {
+        if (g_interrupted || stop.stop_requested()) {
+            return std::unexpected("Operation interrupted by user");
+        }
 
-        if (!fd) {
-            return std::unexpected(get_error_message(errno, "create"));
+        const std::size_t len = std::min(chunk, region.length - offset);
+        if (write) {
+            payload.fill(std::span{base + offset, len}, offset);
+        } else {
+            // memcpy rather than a uint64_t* cast: the mapping holds bytes, not words.
+            for (std::size_t i = 0; i + sizeof(std::uint64_t) <= len; i += sizeof(std::uint64_t)) {
+                std::uint64_t word;
+                std::memcpy(&word, base + offset + i, sizeof(word));
+                checksum += word;
+            }
         }
+        progress.update(offset / chunk + 1);
+    }
 
-        print_storage_warning(success_mode, false);
+    if (write && ::msync(region.addr, region.length, MS_SYNC) == -1) {
+        return std::unexpected("Disk sync failed: " + get_error_message(errno, "sync"));
+    }
 
-        {
-            off_t prealloc_bytes = static_cast<off_t>(total_bytes);
-            int prealloc_rc = ::posix_fallocate(fd.get(), 0, prealloc_bytes);
-            if (prealloc_rc != 0 && prealloc_rc != EINVAL && prealloc_rc != ENOTSUP) {
-                return std::unexpected(std::format("Preallocation failed: {}",
-                                                   std::system_category().message(prealloc_rc)));
+    // Keeps the read loop from being optimized away.
+    volatile std::uint64_t sink = checksum;
+    (void)sink;
+    return total_bytes;
+}
+
+// Runs one write or read pass of `engine` over an already-open file and returns the bytes
+// moved. Durability is part of the measured write: the caller's timer includes the flush.
+// write_mem and read_mem hold one block_size slot per in-flight request.
+[[nodiscard]] std::expected<std::uint64_t, std::string> run_engine_io(
+    DiskEngine engine,
+    int fd,
+    std::uint64_t total_bytes,
+    bool write,
+    std::size_t block_size,
+    std::span<std::byte> write_mem,
+    std::span<std::byte> read_mem,
+    const PayloadGenerator& payload,
+    std::string& io_path,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::string_view label,
+    std::stop_token stop) {
+    switch (engine) {
+        case DiskEngine::Psync: {
+            io_path = "pread/pwrite (page cache)";
+            auto res = run_psync_io(fd,
+                                    total_bytes,
+                                    write,
+                                    (write ? write_mem : read_mem).first(block_size),
+                                    payload,
+                                    progress_cb,
+                                    label,
+                                    stop);
+            if (res && write && ::fdatasync(fd) == -1) {
+                return std::unexpected("Disk sync failed: " + get_error_message(errno, "sync"));
             }
+            return res;
         }
+        case DiskEngine::Mmap:
+            io_path = write ? "mmap + msync (page cache)"
+                            : "mmap + MADV_SEQUENTIAL (page cache)";
+            return run_mmap_io(
+                fd, total_bytes, write, block_size, payload, progress_cb, label, stop);
+        case DiskEngine::IoUringDirect:
+        case DiskEngine::IoUringBuffered:
+            break;
+    }
 
 #ifdef USE_IO_URING
-        io_uring ring{};
-        int ret = io_uring_queue_init(queue_depth_write, &ring, 0);
-        if (ret != 0) {
-            return std::unexpected(
-                std::format("Skipped: io_uring feature not available (Kernel <= 5.4?). Error: {}",
-                            std::system_category().message(-ret)));
-        }
-
-        auto res = run_uring_io(true,
-                                ring,
-                                fd.get(),
-                                total_write_blocks,
-                                total_bytes,
-                                write_block_size,
-                                std::span{buffer.get(), write_block_size},
-                                {},
-                                queue_depth_write,
-                                deadline,
-                                progress_cb,
-                                write_label,
-                                stop);
-        io_uring_queue_exit(&ring);
-        if (!res)
-            return std::unexpected(res.error());
+    const int queue_depth = write ? Config::IO_WRITE_QUEUE_DEPTH : Config::IO_READ_QUEUE_DEPTH;
+    io_uring ring{};
+    auto setup = open_ring(ring, static_cast<unsigned>(queue_depth), {}, fd, read_mem);
+    if (!setup) {
+        return std::unexpected(setup.error());
+    }
+    RingGuard ring_guard{ring};
+
+    UringPass pass;
+    pass.fd = fd;
+    pass.total_ops = (total_bytes + block_size - 1) / block_size;
+    pass.span_bytes = total_bytes;
+    pass.block_size = block_size;
+    pass.read_percent = write ? 0 : 100;
+    pass.queue_depth = queue_depth;
+    pass.write_buffer = write_mem;
+    pass.payload = &payload;
+    pass.read_pool = read_mem;
+    pass.deadline = high_resolution_clock::now() + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+    pass.registration = register_uring_resources(ring, fd, write_mem, read_mem);
+    io_path = describe_uring_path(*setup, pass.registration);
+    if (engine == DiskEngine::IoUringBuffered)
+        io_path += " (page cache)";
+
+    auto res = run_uring_io(ring, pass, progress_cb, label, stop);
+    if (!res)
+        return std::unexpected(res.error());
+    if (write && ::fdatasync(fd) == -1) {
+        return std::unexpected("Disk sync failed: " + get_error_message(errno, "sync"));
+    }
+    return res->bytes;
 #else
-        return std::unexpected(
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+}
+
+struct CommitLoopStats {
+    std::uint64_t commits = 0;
+    duration<double> elapsed{};
+};
+
+// Drives `commit(offset, len)` back to back for `phase` and records each call's latency.
+// Offsets advance like a log and wrap at wrap_bytes, the way WAL segments are recycled.
+template <typename CommitFn>
+[[nodiscard]] std::expected<CommitLoopStats, std::string> run_commit_loop(
+    CommitFn&& commit,
+    std::size_t record_size,
+    std::uint64_t wrap_bytes,
+    seconds phase,
+    LatencyHistogram& histogram,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::string_view label,
+    std::stop_token stop) {
+    const auto start = high_resolution_clock::now();
+    const auto soft_deadline = start + phase;
+    const auto total_ms = static_cast<std::size_t>(duration_cast<milliseconds>(phase).count());
+    BlockProgress progress{progress_cb, label, total_ms};
+
+    CommitLoopStats stats;
+    std::uint64_t offset = 0;
+    auto now = start;
+    while (now < soft_deadline) {
+        if (g_interrupted || stop.stop_requested()) {
+            return std::unexpected("Operation interrupted by user");
+        }
+
+        if (offset + record_size > wrap_bytes)
+            offset = 0;
+
+        auto res = commit(offset, record_size);
+        if (!res)
+            return std::unexpected(res.error());
+
+        const auto done = high_resolution_clock::now();
+        histogram.record(
+            static_cast<std::uint64_t>(duration_cast<nanoseconds>(done - now).count()));
+        now = done;
+        offset += record_size;
+        ++stats.commits;
+        progress.update(
+            std::min(total_ms, static_cast<std::size_t>(
+                                   duration_cast<milliseconds>(now - start).count())));
+    }
+
+    stats.elapsed = now - start;
+    return stats;
+}
+
+// Metadata phases run in this order over the same files: create, stat the new name,
+// rename in place, unlink the new name.
+enum class MetaOp { Create, Stat, Rename, Unlink };
+constexpr std::array<MetaOp, 4> META_OPS = {
+    MetaOp::Create, MetaOp::Stat, MetaOp::Rename, MetaOp::Unlink};
+
+std::string_view meta_op_name(MetaOp op) noexcept {
+    switch (op) {
+        case MetaOp::Create:
+            return "Create";
+        case MetaOp::Stat:
+            return "Stat";
+        case MetaOp::Rename:
+            return "Rename";
+        case MetaOp::Unlink:
+            return "Unlink";
+    }
+    return "Unknown";
+}
+
+struct MetaFile {
+    int dir_fd = -1;
+    std::string name;
+    std::string renamed;
+};
+
+// Creates root and dir_count subdirectories d0..dN under it, returning a descriptor for
+// each so per-file ops resolve one path component instead of the whole path.
+std::expected<std::vector<FileDescriptor>, std::string> make_test_tree(
+    const std::filesystem::path& root, int dir_count) {
+    std::error_code ec;
+    std::filesystem::create_directory(root, ec);
+    if (ec)
+        return std::unexpected(std::format("Cannot create {}: {}", root.string(), ec.message()));
+
+    std::vector<FileDescriptor> dir_fds;
+    dir_fds.reserve(static_cast<std::size_t>(dir_count));
+    for (int d = 0; d < dir_count; ++d) {
+        const auto dir = root / std::format("d{}", d);
+        std::filesystem::create_directory(dir, ec);
+        FileDescriptor fd(::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (ec || !fd)
+            return std::unexpected(std::format("Cannot create {}", dir.string()));
+        dir_fds.push_back(std::move(fd));
+    }
+    return dir_fds;
+}
+
+struct SmallFile {
+    int dir_fd = -1;
+    std::string name;
+    std::size_t size = 0;
+    std::uint64_t index = 0;  // payload offset key
+};
+
+// Whole-file write or read with open/close around it, as a plain syscall sequence.
+std::expected<void, std::string> run_small_files_syscalls(bool write,
+                                                          std::span<const SmallFile> files,
+                                                          std::span<std::byte> buffer,
+                                                          const PayloadGenerator& payload,
+                                                          std::atomic<std::uint64_t>& done,
+                                                          std::stop_token stop) {
+    for (const SmallFile& file : files) {
+        if (g_interrupted || stop.stop_requested())
+            break;
+
+        auto data = buffer.first(file.size);
+        FileDescriptor fd(::openat(file.dir_fd,
+                                   file.name.c_str(),
+                                   write ? (O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC)
+                                         : (O_RDONLY | O_CLOEXEC),
+                                   0600));
+        if (!fd) {
+            return std::unexpected(
+                std::format("open failed: {}", std::system_category().message(errno)));
+        }
+
+        if (write)
+            payload.fill(data, file.index * Config::IO_SMALL_FILE_SIZES.back());
+        ssize_t rc = 0;
+        do {
+            rc = write ? ::write(fd.get(), data.data(), data.size())
+                       : ::read(fd.get(), data.data(), data.size());
+        } while (rc < 0 && errno == EINTR);
+        if (rc < 0)
+            return std::unexpected(get_error_message(errno, write ? "write" : "read"));
+        if (rc != static_cast<ssize_t>(data.size())) {
+            return std::unexpected(std::format("Short {} on {} ({} of {} bytes)",
+                                               write ? "write" : "read",
+                                               file.name,
+                                               rc,
+                                               data.size()));
+        }
+        done.fetch_add(1, std::memory_order_relaxed);
+    }
+    return {};
+}
+
+std::expected<void, std::string> run_meta_syscalls(MetaOp op,
+                                                   std::span<const MetaFile> files,
+                                                   std::atomic<std::uint64_t>& done,
+                                                   std::stop_token stop) {
+    for (const MetaFile& file : files) {
+        if (g_interrupted || stop.stop_requested())
+            break;
+
+        int rc = 0;
+        switch (op) {
+            case MetaOp::Create: {
+                rc = ::openat(file.dir_fd,
+                              file.name.c_str(),
+                              O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC,
+                              0600);
+                if (rc >= 0)
+                    rc = ::close(rc);
+                break;
+            }
+            case MetaOp::Stat: {
+                struct stat st{};
+                rc = ::fstatat(file.dir_fd, file.name.c_str(), &st, AT_SYMLINK_NOFOLLOW);
+                break;
+            }
+            case MetaOp::Rename:
+                rc = ::renameat(file.dir_fd, file.name.c_str(), file.dir_fd, file.renamed.c_str());
+                break;
+            case MetaOp::Unlink:
+                rc = ::unlinkat(file.dir_fd, file.renamed.c_str(), 0);
+                break;
+        }
+
+        if (rc < 0) {
+            return std::unexpected(std::format(
+                "{} failed: {}", meta_op_name(op), std::system_category().message(errno)));
+        }
+        done.fetch_add(1, std::memory_order_relaxed);
+    }
+    return {};
+}
+
+#ifdef USE_IO_URING
+
+constexpr std::array<int, 5> META_URING_OPCODES = {
+    IORING_OP_OPENAT, IORING_OP_CLOSE, IORING_OP_STATX, IORING_OP_RENAMEAT, IORING_OP_UNLINKAT};
+
+[[nodiscard]] bool meta_uring_supported() {
+    io_uring ring{};
+    if (io_uring_queue_init(4, &ring, 0) != 0)
+        return false;
+    RingGuard guard{ring};
+
+    io_uring_probe* probe = io_uring_get_probe_ring(&ring);
+    if (!probe)
+        return false;
+    const bool supported = std::ranges::all_of(
+        META_URING_OPCODES, [&](int opcode) { return io_uring_opcode_supported(probe, opcode); });
+    io_uring_free_probe(probe);
+    return supported;
+}
+
+// Open flags for the direct-descriptor chains. No O_CLOEXEC: a fixed slot has no fd table
+// entry for it to apply to, and the kernel rejects OPENAT_DIRECT carrying it with EINVAL.
+constexpr int SMALL_FILE_DIRECT_WRITE_FLAGS = O_CREAT | O_EXCL | O_WRONLY;
+constexpr int SMALL_FILE_DIRECT_READ_FLAGS = O_RDONLY;
+
+// Direct descriptors (OPENAT with a fixed-file slot, 5.15+) are what lets open, write and
+// close be linked: the write names the slot the open will fill. Probed by opening "/" with
+// the read flags the test itself uses, so a pass here means the chains will be accepted.
+[[nodiscard]] bool direct_open_supported() {
+    io_uring ring{};
+    if (io_uring_queue_init(4, &ring, 0) != 0)
+        return false;
+    RingGuard guard{ring};
+    if (io_uring_register_files_sparse(&ring, 1) != 0)
+        return false;
+
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+    io_uring_prep_openat_direct(sqe, AT_FDCWD, "/", SMALL_FILE_DIRECT_READ_FLAGS, 0, 0);
+    io_uring_sqe_set_flags(sqe, IOSQE_IO_LINK);
+    sqe = io_uring_get_sqe(&ring);
+    io_uring_prep_close_direct(sqe, 0);
+
+    if (io_uring_submit_and_wait(&ring, 2) < 2)
+        return false;
+    bool ok = true;
+    for (int i = 0; i < 2; ++i) {
+        io_uring_cqe* cqe = nullptr;
+        if (io_uring_wait_cqe(&ring, &cqe) != 0)
+            return false;
+        ok = ok && cqe->res >= 0;
+        io_uring_cqe_seen(&ring, cqe);
+    }
+    return ok;
+}
+
+// Keeps queue_depth files in flight as linked OPENAT_DIRECT -> WRITE/READ -> CLOSE
+// chains, one fixed-file slot and one buffer slot per chain. A chain is done when all
+// three of its completions are in; a failed link cancels the rest, so the first error
+// other than ECANCELED is the one reported, after the ring has drained.
+std::expected<void, std::string> run_small_files_uring(io_uring& ring,
+                                                       int queue_depth,
+                                                       bool write,
+                                                       std::span<const SmallFile> files,
+                                                       std::span<std::byte> buffers,
+                                                       const PayloadGenerator& payload,
+                                                       std::atomic<std::uint64_t>& done,
+                                                       std::stop_token stop) {
+    constexpr std::size_t slot_bytes = Config::IO_SMALL_FILE_SIZES.back();
+    const auto depth = static_cast<std::size_t>(std::max(1, queue_depth));
+
+    std::vector<std::size_t> free_slots(depth);
+    std::iota(free_slots.rbegin(), free_slots.rend(), std::size_t{0});
+    std::vector<int> pending(depth, 0);
+    std::vector<std::size_t> slot_size(depth, 0);
+
+    std::string error;
+    std::size_t next = 0;
+    std::size_t in_flight = 0;
+
+    while (next < files.size() || in_flight > 0) {
+        if (g_interrupted || stop.stop_requested() || !error.empty())
+            next = files.size();
+
+        while (next < files.size() && !free_slots.empty() &&
+               io_uring_sq_space_left(&ring) >= 3) {
+            const std::size_t slot = free_slots.back();
+            free_slots.pop_back();
+            const SmallFile& file = files[next++];
+            std::byte* data = buffers.data() + slot * slot_bytes;
+            const auto len = static_cast<unsigned>(file.size);
+            const auto fixed = static_cast<int>(slot);
+
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            io_uring_prep_openat_direct(
+                sqe,
+                file.dir_fd,
+                file.name.c_str(),
+                write ? SMALL_FILE_DIRECT_WRITE_FLAGS : SMALL_FILE_DIRECT_READ_FLAGS,
+                0600,
+                static_cast<unsigned>(slot));
+            io_uring_sqe_set_flags(sqe, IOSQE_IO_LINK);
+            io_uring_sqe_set_data64(sqe, slot);
+
+            sqe = io_uring_get_sqe(&ring);
+            if (write) {
+                payload.fill(std::span{data, file.size}, file.index * slot_bytes);
+                io_uring_prep_write(sqe, fixed, data, len, 0);
+            } else {
+                io_uring_prep_read(sqe, fixed, data, len, 0);
+            }
+            io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE | IOSQE_IO_LINK);
+            io_uring_sqe_set_data64(sqe, (std::uint64_t{1} << 32) | slot);
+
+            sqe = io_uring_get_sqe(&ring);
+            io_uring_prep_close_direct(sqe, static_cast<unsigned>(slot));
+            io_uring_sqe_set_data64(sqe, (std::uint64_t{2} << 32) | slot);
+
+            pending[slot] = 3;
+            slot_size[slot] = file.size;
+            ++in_flight;
+        }
+
+        if (in_flight == 0)
+            break;
+
+        int rc = io_uring_submit_and_wait(&ring, 1);
+        if (rc < 0) {
+            if (rc == -EINTR)
+                continue;
+            return std::unexpected(uring_error(rc, "submit"));
+        }
+
+        unsigned head;
+        unsigned count = 0;
+        io_uring_cqe* cqe = nullptr;
+        io_uring_for_each_cqe(&ring, head, cqe) {
+            count++;
+            const std::uint64_t data = io_uring_cqe_get_data64(cqe);
+            const auto slot = static_cast<std::size_t>(data & 0xFFFFFFFF);
+            const auto stage = static_cast<int>(data >> 32);
+
+            if (cqe->res < 0 && cqe->res != -ECANCELED && error.empty()) {
+                constexpr std::array<std::string_view, 3> stages = {"open", "io", "close"};
+                error = std::format("{} failed: {}",
+                                    stages[static_cast<std::size_t>(stage)],
+                                    std::system_category().message(-cqe->res));
+            } else if (stage == 1 && cqe->res >= 0 &&
+                       static_cast<std::size_t>(cqe->res) != slot_size[slot] && error.empty()) {
+                error = std::format("Short {} ({} of {} bytes)",
+                                    write ? "write" : "read",
+                                    cqe->res,
+                                    slot_size[slot]);
+            }
+
+            if (--pending[slot] == 0) {
+                free_slots.push_back(slot);
+                --in_flight;
+                if (error.empty())
+                    done.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        io_uring_cq_advance(&ring, count);
+    }
+
+    if (!error.empty())
+        return std::unexpected(error);
+    return {};
+}
+
+// Keeps queue_depth metadata ops in flight. A create is an OPENAT whose completion
+// queues a CLOSE of the returned fd on the same slot; the file counts once it is closed.
+// After an error or interrupt no new ops are issued, but the loop keeps reaping until the
+// ring is empty so every opened fd is closed and no statx still targets stat_bufs.
+std::expected<void, std::string> run_meta_uring(io_uring& ring,
+                                                int queue_depth,
+                                                MetaOp op,
+                                                std::span<const MetaFile> files,
+                                                std::atomic<std::uint64_t>& done,
+                                                std::stop_token stop) {
+    constexpr std::uint64_t CLOSE_TAG = 1ULL << 63;
+    const auto depth = static_cast<std::size_t>(std::max(1, queue_depth));
+
+    std::vector<struct statx> stat_bufs(depth);
+    std::vector<std::size_t> free_slots(depth);
+    std::iota(free_slots.rbegin(), free_slots.rend(), std::size_t{0});
+    std::vector<std::pair<int, std::size_t>> pending_close;
+    std::string error;
+
+    // Only reached with ops still in flight if the ring itself failed; close what we hold.
+    struct PendingCloser {
+        std::vector<std::pair<int, std::size_t>>& fds;
+        ~PendingCloser() {
+            for (auto [fd, slot] : fds)
+                ::close(fd);
+        }
+    } closer{pending_close};
+
+    std::size_t next = 0;
+    std::size_t in_flight = 0;
+
+    while (next < files.size() || in_flight > 0) {
+        if (g_interrupted || stop.stop_requested() || !error.empty())
+            next = files.size();
+
+        while (!pending_close.empty()) {
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            if (!sqe)
+                break;
+            auto [fd, slot] = pending_close.back();
+            pending_close.pop_back();
+            io_uring_prep_close(sqe, fd);
+            io_uring_sqe_set_data64(sqe, CLOSE_TAG | slot);
+        }
+
+        while (next < files.size() && !free_slots.empty()) {
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            if (!sqe)
+                break;
+
+            const std::size_t slot = free_slots.back();
+            free_slots.pop_back();
+            const MetaFile& file = files[next++];
+
+            switch (op) {
+                case MetaOp::Create:
+                    io_uring_prep_openat(sqe,
+                                         file.dir_fd,
+                                         file.name.c_str(),
+                                         O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC,
+                                         0600);
+                    break;
+                case MetaOp::Stat:
+                    io_uring_prep_statx(sqe,
+                                        file.dir_fd,
+                                        file.name.c_str(),
+                                        AT_SYMLINK_NOFOLLOW,
+                                        STATX_BASIC_STATS,
+                                        &stat_bufs[slot]);
+                    break;
+                case MetaOp::Rename:
+                    io_uring_prep_renameat(
+                        sqe, file.dir_fd, file.name.c_str(), file.dir_fd, file.renamed.c_str(), 0);
+                    break;
+                case MetaOp::Unlink:
+                    io_uring_prep_unlinkat(sqe, file.dir_fd, file.renamed.c_str(), 0);
+                    break;
+            }
+            io_uring_sqe_set_data64(sqe, slot);
+            ++in_flight;
+        }
+
+        if (in_flight == 0)
+            break;
+
+        int rc = io_uring_submit_and_wait(&ring, 1);
+        if (rc < 0) {
+            if (rc == -EINTR)
+                continue;
+            return std::unexpected(uring_error(rc, "submit"));
+        }
+
+        unsigned head;
+        unsigned count = 0;
+        io_uring_cqe* cqe = nullptr;
+        io_uring_for_each_cqe(&ring, head, cqe) {
+            count++;
+            const std::uint64_t data = io_uring_cqe_get_data64(cqe);
+            const auto slot = static_cast<std::size_t>(data & ~CLOSE_TAG);
+
+            if (cqe->res >= 0 && op == MetaOp::Create && !(data & CLOSE_TAG)) {
+                pending_close.emplace_back(cqe->res, slot);
+                continue;
+            }
+
+            free_slots.push_back(slot);
+            --in_flight;
+            if (cqe->res < 0) {
+                if (error.empty()) {
+                    error = std::format("{} failed: {}",
+                                        (data & CLOSE_TAG) ? "Close" : meta_op_name(op),
+                                        std::system_category().message(-cqe->res));
+                }
+            } else if (error.empty()) {
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        io_uring_cq_advance(&ring, count);
+    }
+
+    if (!error.empty())
+        return std::unexpected(error);
+    return {};
+}
+
+#endif
+
+}  // namespace
+
+std::expected<DiskIORunResult, std::string> DiskBenchmark::run_io_test(
+    int size_mb,
+    std::string_view label,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::filesystem::path directory = options.directory.empty()
+                                                ? std::filesystem::current_path()
+                                                : std::filesystem::path(options.directory);
+    const std::string filename =
+        (directory / std::format("{}.{}", Config::TEST_FILENAME, getpid())).string();
+    FileCleaner cleaner{filename};
+
+    const size_t write_block_size = Config::IO_WRITE_BLOCK_SIZE;
+    const size_t read_block_size = Config::IO_READ_BLOCK_SIZE;
+    const int queue_depth_write = std::max(1, Config::IO_WRITE_QUEUE_DEPTH);
+    const int queue_depth_read = std::max(1, Config::IO_READ_QUEUE_DEPTH);
+
+    std::uint64_t required = static_cast<std::uint64_t>(size_mb) * 1024 * 1024;
+
+    if (!is_disk_space_available(directory, required)) {
+        return std::unexpected("Insufficient free space for disk test (needs " +
+                               format_bytes(required) + ")");
+    }
+
+    // One write slot per in-flight request so each can carry its own payload.
+    const std::size_t write_pool_size =
+        static_cast<std::size_t>(queue_depth_write) * write_block_size;
+    auto buffer_res = make_aligned_buffer(write_pool_size, Config::IO_ALIGNMENT);
+    if (!buffer_res) {
+        return std::unexpected(buffer_res.error());
+    }
+    auto buffer = std::move(buffer_res.value());
+
+    auto write_mem = std::span{buffer.get(), write_pool_size};
+    optimize_memory_region(write_mem);
+    const PayloadGenerator payload{options.compressible_percent};
+
+    const std::size_t read_pool_size = static_cast<std::size_t>(queue_depth_read) * read_block_size;
+    auto read_pool_res = make_aligned_buffer(read_pool_size, Config::IO_ALIGNMENT);
+    if (!read_pool_res) {
+        return std::unexpected(read_pool_res.error());
+    }
+    auto read_pool = std::move(read_pool_res.value());
+
+    auto read_mem = std::span{read_pool.get(), read_pool_size};
+    optimize_memory_region(read_mem);
+    fill_pattern(read_mem);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+    LatencyStats write_latency;
+    std::string write_io_path;
+    std::string read_io_path;
+
+    // Convergence mode samples interval throughput so each phase can end once its mean is
+    // pinned down; the read phase then covers only what the write phase got to.
+    const auto sample_interval = milliseconds(Config::IO_CONVERGE_SAMPLE_MS);
+    std::vector<std::uint64_t> interval_bytes;
+    if (options.converge_tolerance > 0) {
+        interval_bytes.resize(static_cast<std::size_t>(
+            seconds(Config::DISK_BENCHMARK_MAX_SECONDS) / sample_interval));
+    }
+    bool converged = false;
+    std::optional<double> write_ci_mbps;
+    std::optional<double> read_ci_mbps;
+
+    // Kernel counters for the backing device, snapshotted around each phase.
+    const auto block_device = SystemInfo::get_block_device(directory.string());
+    auto disk_stats = [&]() -> std::optional<DiskStatSnapshot> {
+        return block_device ? SystemInfo::get_disk_stats(*block_device) : std::nullopt;
+    };
+    std::optional<DiskKernelStats> write_kernel;
+    std::optional<DiskKernelStats> read_kernel;
+
+    const auto write_stats_before = disk_stats();
+    auto start = high_resolution_clock::now();
+    auto deadline = start + std::chrono::seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+    const std::uint64_t total_bytes = static_cast<std::uint64_t>(size_mb) * 1024 * 1024;
+    const std::uint64_t total_write_blocks =
+        (total_bytes + write_block_size - 1) / write_block_size;
+    std::uint64_t written_bytes = total_bytes;
+
+    {
+        const std::string write_label = std::string(label) + " Write";
+
+        std::error_code ec;
+        std::filesystem::remove(filename, ec);
+
+        const int base_flags = O_WRONLY | O_CREAT | O_TRUNC | O_EXCL;
+
+#ifndef O_DIRECT
+        return std::unexpected("FATAL: O_DIRECT is not available on this platform compilation.");
+#endif
+
+        auto [fd, success_mode] = open_benchmark_file(filename, base_flags, 0600);
+
+        if (!fd) {
+            return std::unexpected(get_error_message(errno, "create"));
+        }
+
+        print_storage_warning(success_mode, false);
+
+        {
+            off_t prealloc_bytes = static_cast<off_t>(total_bytes);
+            int prealloc_rc = ::posix_fallocate(fd.get(), 0, prealloc_bytes);
+            if (prealloc_rc != 0 && prealloc_rc != EINVAL && prealloc_rc != ENOTSUP) {
+                return std::unexpected(std::format("Preallocation failed: {}",
+                                                   std::system_category().message(prealloc_rc)));
+            }
+        }
+
+#ifdef USE_IO_URING
+        io_uring ring{};
+        auto setup = open_ring(ring,
+                               static_cast<unsigned>(queue_depth_write),
+                               options,
+                               fd.get(),
+                               write_mem);
+        if (!setup) {
+            return std::unexpected(setup.error());
+        }
+        RingGuard ring_guard{ring};
+
+        UringPass pass;
+        pass.fd = fd.get();
+        pass.total_ops = total_write_blocks;
+        pass.span_bytes = total_bytes;
+        pass.block_size = write_block_size;
+        pass.queue_depth = queue_depth_write;
+        pass.write_buffer = write_mem;
+        pass.payload = &payload;
+        pass.deadline = deadline;
+        pass.histogram = histogram.get();
+        pass.registration = register_uring_resources(ring, fd.get(), write_mem, {});
+        pass.interval_bytes = interval_bytes;
+        pass.sample_interval = sample_interval;
+        pass.converge_tolerance = options.converge_tolerance;
+        pass.converge_after = seconds(Config::IO_CONVERGE_MIN_SECONDS);
+        write_io_path = describe_uring_path(*setup, pass.registration);
+
+        auto res = run_uring_io(ring, pass, progress_cb, write_label, stop);
+        if (!res)
+            return std::unexpected(res.error());
+        write_latency = histogram->summarize();
+
+        if (res->converged) {
+            converged = true;
+            written_bytes = res->bytes;
+        }
+        const auto write_closed = std::min(
+            interval_bytes.size(), static_cast<std::size_t>(res->elapsed / sample_interval));
+        if (write_closed >= Config::IO_CONVERGE_MIN_SAMPLES) {
+            write_ci_mbps = interval_confidence(std::span{interval_bytes}.first(write_closed),
+                                                sample_interval)
+                                .half_width /
+                            (1024.0 * 1024.0);
+        }
+#else
+        return std::unexpected(
             "Skipped: Binary compiled without io_uring support. Cannot benchmark.");
 #endif
 
@@ -479,8 +1775,14 @@ std::expected<DiskIORunResult, std::string> DiskBenchmark::run_io_test(
 
     auto end_write = high_resolution_clock::now();
     duration<double> diff_write = end_write - start;
-    double write_speed =
-        diff_write.count() <= 0 ? 0.0 : static_cast<double>(size_mb) / diff_write.count();
+    if (auto after = disk_stats(); write_stats_before && after) {
+        write_kernel = kernel_stats_delta(
+            *block_device, *write_stats_before, *after, true, diff_write, write_block_size);
+    }
+    const double written_mb = static_cast<double>(written_bytes) / (1024.0 * 1024.0);
+    double write_speed = diff_write.count() <= 0 ? 0.0 : written_mb / diff_write.count();
+    const std::uint64_t total_read_blocks =
+        (written_bytes + read_block_size - 1) / read_block_size;
 
     int rd_flags = O_RDONLY;
     auto [read_fd, read_success_mode] = open_benchmark_file(filename, rd_flags, 0);
@@ -490,35 +1792,57 @@ std::expected<DiskIORunResult, std::string> DiskBenchmark::run_io_test(
     }
 
     print_storage_warning(read_success_mode, true);
+    const auto read_stats_before = disk_stats();
     auto read_start = high_resolution_clock::now();
 
     deadline = read_start + std::chrono::seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
     const std::string read_label = std::string(label) + " Read";
+    std::uint64_t read_bytes = written_bytes;
 
 #ifdef USE_IO_URING
     io_uring ring{};
-    int ret = io_uring_queue_init(queue_depth_read, &ring, 0);
-    if (ret != 0) {
-        return std::unexpected(std::format("FATAL: io_uring init failed for read: {}",
-                                           std::system_category().message(-ret)));
-    }
-
-    auto res = run_uring_io(false,
-                            ring,
-                            read_fd.get(),
-                            total_read_blocks,
-                            total_bytes,
-                            read_block_size,
-                            std::span<std::byte>{},
-                            read_buffers,
-                            queue_depth_read,
-                            deadline,
-                            progress_cb,
-                            read_label,
-                            stop);
-    io_uring_queue_exit(&ring);
+    auto setup = open_ring(
+        ring, static_cast<unsigned>(queue_depth_read), options, read_fd.get(), read_mem);
+    if (!setup) {
+        return std::unexpected("FATAL: io_uring init failed for read: " + setup.error());
+    }
+    RingGuard ring_guard{ring};
+
+    UringPass pass;
+    pass.fd = read_fd.get();
+    pass.total_ops = total_read_blocks;
+    pass.span_bytes = written_bytes;
+    pass.block_size = read_block_size;
+    pass.read_percent = 100;
+    pass.queue_depth = queue_depth_read;
+    pass.read_pool = read_mem;
+    pass.deadline = deadline;
+    histogram->reset();
+    pass.histogram = histogram.get();
+    pass.registration = register_uring_resources(ring, read_fd.get(), {}, read_mem);
+    std::ranges::fill(interval_bytes, std::uint64_t{0});
+    pass.interval_bytes = interval_bytes;
+    pass.sample_interval = sample_interval;
+    pass.converge_tolerance = options.converge_tolerance;
+    pass.converge_after = seconds(Config::IO_CONVERGE_MIN_SECONDS);
+    read_io_path = describe_uring_path(*setup, pass.registration);
+
+    auto res = run_uring_io(ring, pass, progress_cb, read_label, stop);
     if (!res)
         return std::unexpected(res.error());
+
+    if (res->converged) {
+        converged = true;
+        read_bytes = res->bytes;
+    }
+    const auto read_closed =
+        std::min(interval_bytes.size(), static_cast<std::size_t>(res->elapsed / sample_interval));
+    if (read_closed >= Config::IO_CONVERGE_MIN_SAMPLES) {
+        read_ci_mbps =
+            interval_confidence(std::span{interval_bytes}.first(read_closed), sample_interval)
+                .half_width /
+            (1024.0 * 1024.0);
+    }
 #endif
 
     if (progress_cb)
@@ -528,8 +1852,1708 @@ std::expected<DiskIORunResult, std::string> DiskBenchmark::run_io_test(
 
     auto end_read = high_resolution_clock::now();
     duration<double> diff_read = end_read - read_start;
-    double read_speed =
-        diff_read.count() <= 0 ? 0.0 : static_cast<double>(size_mb) / diff_read.count();
+    if (auto after = disk_stats(); read_stats_before && after) {
+        read_kernel = kernel_stats_delta(
+            *block_device, *read_stats_before, *after, false, diff_read, read_block_size);
+    }
+    const double read_mb = static_cast<double>(read_bytes) / (1024.0 * 1024.0);
+    double read_speed = diff_read.count() <= 0 ? 0.0 : read_mb / diff_read.count();
+    const LatencyStats read_latency = histogram->summarize();
+
+    // Same read again, now checking every sector against what the write phase generated,
+    // so the cost of verification shows up as the gap between the two read speeds.
+    double verify_speed = 0.0;
+#ifdef USE_IO_URING
+    if (options.verify) {
+        const std::string verify_label = std::string(label) + " Verify";
+        auto verify_start = high_resolution_clock::now();
+        pass.verify = &payload;
+        pass.histogram = nullptr;
+        pass.interval_bytes = {};  // always check everything that was written
+        pass.converge_tolerance = 0.0;
+        pass.deadline = verify_start + std::chrono::seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+
+        auto verified = run_uring_io(ring, pass, progress_cb, verify_label, stop);
+        if (!verified)
+            return std::unexpected(verified.error());
+
+        duration<double> diff_verify = high_resolution_clock::now() - verify_start;
+        verify_speed = diff_verify.count() <= 0 ? 0.0 : written_mb / diff_verify.count();
+    }
+#endif
+
+    DiskIORunResult result;
+    result.label = std::string(label);
+    result.write_mbps = write_speed;
+    result.read_mbps = read_speed;
+    result.write_latency = write_latency;
+    result.read_latency = read_latency;
+    result.verified = options.verify;
+    result.verify_read_mbps = verify_speed;
+    result.converged = converged;
+    result.bytes_written = written_bytes;
+    result.write_ci_mbps = write_ci_mbps;
+    result.read_ci_mbps = read_ci_mbps;
+    result.write_kernel = write_kernel;
+    result.read_kernel = read_kernel;
+    result.io_path = write_io_path == read_io_path
+                         ? write_io_path
+                         : std::format("write: {}, read: {}", write_io_path, read_io_path);
+    return result;
+}
+
+std::expected<DiskRawDeviceResult, std::string> DiskBenchmark::run_raw_device_test(
+    const std::string& device,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+#ifndef O_DIRECT
+    return std::unexpected("FATAL: O_DIRECT is not available on this platform compilation.");
+#endif
+
+    // O_RDONLY is the guarantee: the kernel rejects any write on this descriptor.
+    FileDescriptor fd(::open(device.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC));
+    if (!fd) {
+        return std::unexpected(
+            std::format("Cannot open {}: {}", device, std::system_category().message(errno)));
+    }
+
+    struct stat st{};
+    if (::fstat(fd.get(), &st) != 0 || !S_ISBLK(st.st_mode)) {
+        return std::unexpected(device + " is not a block device");
+    }
+
+    std::uint64_t device_bytes = 0;
+    if (::ioctl(fd.get(), BLKGETSIZE64, &device_bytes) != 0 || device_bytes == 0) {
+        return std::unexpected(std::format("Cannot read size of {}", device));
+    }
+
+    // Queue limits live on the whole disk; a partition's sysfs node sits inside it. Without
+    // sysfs (not mounted, or a container) the block size comes from BLKSSZGET and the max
+    // I/O size stays unknown.
+    std::error_code ec;
+    auto sys_dev = std::filesystem::canonical(
+        std::format("/sys/dev/block/{}:{}", major(st.st_rdev), minor(st.st_rdev)), ec);
+    const bool have_sysfs = !ec;
+    if (have_sysfs && std::filesystem::exists(sys_dev / "partition", ec))
+        sys_dev = sys_dev.parent_path();
+
+    std::size_t logical_block = 0;
+    std::size_t max_io = 0;
+    if (have_sysfs) {
+        logical_block = static_cast<std::size_t>(
+            read_sysfs_number(sys_dev / "queue/logical_block_size").value_or(0));
+        max_io = static_cast<std::size_t>(
+            read_sysfs_number(sys_dev / "queue/max_sectors_kb").value_or(0) * 1024);
+    }
+    if (logical_block == 0) {
+        int ssz = 0;
+        logical_block =
+            ::ioctl(fd.get(), BLKSSZGET, &ssz) == 0 && ssz > 0 ? static_cast<std::size_t>(ssz)
+                                                               : 512;
+    }
+
+    // Largest request the queue takes without splitting, trimmed to whole logical blocks.
+    std::size_t seq_block = Config::IO_READ_BLOCK_SIZE;
+    if (max_io > 0)
+        seq_block = std::min(seq_block, max_io);
+    seq_block = std::max(logical_block, seq_block / logical_block * logical_block);
+    const std::size_t random_block = std::max(Config::IO_RANDOM_BLOCK_SIZE, logical_block);
+    const std::size_t alignment = std::max(Config::IO_ALIGNMENT, logical_block);
+
+    const int seq_depth = std::max(1, Config::IO_READ_QUEUE_DEPTH);
+    const int random_depth = std::max(1, Config::IO_RANDOM_QUEUE_DEPTH);
+    const std::size_t pool_size = std::max(static_cast<std::size_t>(seq_depth) * seq_block,
+                                           static_cast<std::size_t>(random_depth) * random_block);
+    if (device_bytes < seq_block || device_bytes < random_block) {
+        return std::unexpected(device + " is smaller than one read block");
+    }
+
+    auto pool_res = make_aligned_buffer(pool_size, alignment);
+    if (!pool_res) {
+        return std::unexpected(pool_res.error());
+    }
+    auto pool = std::move(pool_res.value());
+    auto read_mem = std::span{pool.get(), pool_size};
+    optimize_memory_region(read_mem);
+    fill_pattern(read_mem);
+
+    DiskRawDeviceResult result;
+    result.device = device;
+    result.size = device_bytes;
+    result.logical_block_size = logical_block;
+    result.max_io_bytes = max_io;
+
+#ifdef USE_IO_URING
+    io_uring ring{};
+    auto setup = open_ring(ring,
+                           static_cast<unsigned>(std::max(seq_depth, random_depth)),
+                           options,
+                           fd.get(),
+                           read_mem.first(seq_block));
+    if (!setup) {
+        return std::unexpected(setup.error());
+    }
+    RingGuard ring_guard{ring};
+
+    const UringRegistration registration = register_uring_resources(ring, fd.get(), {}, read_mem);
+    result.io_path = describe_uring_path(*setup, registration);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+
+    struct Phase {
+        std::string label;
+        std::size_t block_size;
+        int queue_depth;
+        bool random;
+    };
+    const std::array<Phase, 2> phases = {{
+        {std::format(" Seq Read QD{} x {}", seq_depth, format_bytes(seq_block)),
+         seq_block,
+         seq_depth,
+         false},
+        {std::format(" Rand Read QD{} x {}", random_depth, format_bytes(random_block)),
+         random_block,
+         random_depth,
+         true},
+    }};
+
+    for (const auto& phase : phases) {
+        auto now = high_resolution_clock::now();
+
+        UringPass pass;
+        pass.fd = fd.get();
+        pass.span_bytes = device_bytes / phase.block_size * phase.block_size;
+        pass.total_ops = phase.random ? Config::IO_RANDOM_MAX_OPS
+                                      : pass.span_bytes / phase.block_size;
+        pass.block_size = phase.block_size;
+        pass.random_offsets = phase.random;
+        pass.read_percent = 100;
+        pass.queue_depth = phase.queue_depth;
+        pass.read_pool = read_mem;
+        pass.deadline = now + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+        pass.soft_deadline = now + seconds(phase.random ? Config::IO_RANDOM_PHASE_SECONDS
+                                                        : Config::IO_RAW_PHASE_SECONDS);
+        histogram->reset();
+        pass.histogram = histogram.get();
+        pass.registration = registration;
+
+        auto res = run_uring_io(ring, pass, progress_cb, phase.label, stop);
+        if (!res)
+            return std::unexpected(res.error());
+
+        const double secs = res->elapsed.count();
+        DiskRandomPhaseResult phase_result;
+        phase_result.label = phase.label;
+        if (secs > 0) {
+            phase_result.iops = static_cast<double>(res->completed) / secs;
+            phase_result.mbps = static_cast<double>(res->bytes) / (1024.0 * 1024.0) / secs;
+        }
+        phase_result.latency = histogram->summarize();
+        result.phases.push_back(std::move(phase_result));
+    }
+#else
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+
+    return result;
+}
+
+std::expected<DiskMultiPathResult, std::string> DiskBenchmark::run_multi_path_test(
+    std::span<const MountEntry> mounts,
+    int size_mb,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    if (mounts.empty())
+        return std::unexpected("No writable block-device mounts found");
+
+    auto shares_disk = [](const std::vector<std::string>& a, const std::vector<std::string>& b) {
+        return std::ranges::any_of(
+            a, [&](const std::string& disk) { return std::ranges::find(b, disk) != b.end(); });
+    };
+
+    // Grow each group until no remaining mount touches any of its disks, so a mount that
+    // bridges two others (an LV spanning both PVs) pulls them into one group.
+    std::vector<int> group_of(mounts.size(), -1);
+    int group_count = 0;
+    for (std::size_t i = 0; i < mounts.size(); ++i) {
+        if (group_of[i] >= 0)
+            continue;
+
+        group_of[i] = group_count;
+        std::vector<std::string> disks = mounts[i].disks;
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (std::size_t j = i + 1; j < mounts.size(); ++j) {
+                if (group_of[j] < 0 && shares_disk(mounts[j].disks, disks)) {
+                    group_of[j] = group_count;
+                    disks.insert(disks.end(), mounts[j].disks.begin(), mounts[j].disks.end());
+                    grew = true;
+                }
+            }
+        }
+        ++group_count;
+    }
+
+    DiskMultiPathResult result;
+    result.file_size = static_cast<std::uint64_t>(size_mb) * 1024 * 1024;
+    result.groups = group_count;
+    result.paths.resize(mounts.size());
+
+    // One progress bar on a terminal: whichever group reports first owns it until that
+    // group is done, then the next group to report takes over.
+    std::mutex progress_mutex;
+    int progress_owner = -1;
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(static_cast<std::size_t>(group_count));
+
+        for (int group = 0; group < group_count; ++group) {
+            workers.emplace_back([&, group] {
+                const std::function<void(std::size_t, std::size_t, std::string_view)>
+                    group_progress = [&, group](std::size_t done,
+                                                std::size_t total,
+                                                std::string_view label) {
+                        if (!progress_cb)
+                            return;
+                        std::scoped_lock lock(progress_mutex);
+                        if (progress_owner < 0)
+                            progress_owner = group;
+                        if (progress_owner == group)
+                            progress_cb(done, total, label);
+                    };
+
+                for (std::size_t i = 0; i < mounts.size(); ++i) {
+                    if (group_of[i] != group)
+                        continue;
+
+                    const MountEntry& mount = mounts[i];
+                    DiskPathResult& row = result.paths[i];
+                    row.mount_point = mount.mount_point;
+                    row.source = mount.source;
+                    row.fs_type = mount.fs_type;
+                    for (const auto& disk : mount.disks)
+                        row.disks += (row.disks.empty() ? "" : "+") + disk;
+                    row.group = group;
+
+                    if (g_interrupted || stop.stop_requested()) {
+                        row.error = "Interrupted";
+                        continue;
+                    }
+
+                    DiskTestOptions path_options = options;
+                    path_options.directory = mount.mount_point;
+                    auto run = run_io_test(size_mb,
+                                           std::format(" {}", mount.mount_point),
+                                           path_options,
+                                           group_progress,
+                                           stop);
+                    if (run) {
+                        row.write_mbps = run->write_mbps;
+                        row.read_mbps = run->read_mbps;
+                        row.io_path = run->io_path;
+                    } else {
+                        row.error = run.error();
+                    }
+                }
+
+                std::scoped_lock lock(progress_mutex);
+                if (progress_owner == group)
+                    progress_owner = -1;
+            });
+        }
+    }
+
+    return result;
+}
+
+std::expected<DiskRandomResult, std::string> DiskBenchmark::run_random_test(
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
+    FileCleaner cleaner{filename};
+
+    const std::size_t block_size = Config::IO_RANDOM_BLOCK_SIZE;
+    const std::size_t fill_block_size = Config::IO_WRITE_BLOCK_SIZE;
+    const int queue_depth = std::max(1, Config::IO_RANDOM_QUEUE_DEPTH);
+    const std::uint64_t total_bytes =
+        static_cast<std::uint64_t>(Config::IO_RANDOM_FILE_SIZE_MB) * 1024 * 1024;
+
+    if (!is_disk_space_available(std::filesystem::current_path(), total_bytes)) {
+        return std::unexpected("Insufficient free space for random I/O test (needs " +
+                               format_bytes(total_bytes) + ")");
+    }
+
+    auto buffer_res = make_aligned_buffer(fill_block_size, Config::IO_ALIGNMENT);
+    if (!buffer_res) {
+        return std::unexpected(buffer_res.error());
+    }
+    auto buffer = std::move(buffer_res.value());
+
+    auto write_mem = std::span{buffer.get(), fill_block_size};
+    optimize_memory_region(write_mem);
+
+    const std::size_t read_pool_size = static_cast<std::size_t>(queue_depth) * block_size;
+    auto read_pool_res = make_aligned_buffer(read_pool_size, Config::IO_ALIGNMENT);
+    if (!read_pool_res) {
+        return std::unexpected(read_pool_res.error());
+    }
+    auto read_pool = std::move(read_pool_res.value());
+    auto read_mem = std::span{read_pool.get(), read_pool_size};
+    fill_pattern(read_mem);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+
+    DiskRandomResult result;
+    result.queue_depth = queue_depth;
+    result.block_size = block_size;
+
+#ifdef USE_IO_URING
+    const PayloadGenerator payload{options.compressible_percent};
+    auto fd_res = prepare_test_file(
+        filename, total_bytes, payload, progress_cb, " 4K Random (Prepare)", stop);
+    if (!fd_res)
+        return std::unexpected(fd_res.error());
+    FileDescriptor fd = std::move(fd_res.value());
+
+    io_uring ring{};
+    auto setup = open_ring(ring, static_cast<unsigned>(queue_depth), options, fd.get(), read_mem);
+    if (!setup) {
+        return std::unexpected(setup.error());
+    }
+    RingGuard ring_guard{ring};
+
+    const UringRegistration registration =
+        register_uring_resources(ring, fd.get(), write_mem, read_mem);
+    result.io_path = describe_uring_path(*setup, registration);
+
+    struct Phase {
+        std::string_view label;
+        int read_percent;
+    };
+    constexpr std::array<Phase, 3> phases = {{{" 4K Random Read", 100},
+                                              {" 4K Random Write", 0},
+                                              {" 4K Random Mixed 70/30",
+                                               Config::IO_RANDOM_MIXED_READ_PERCENT}}};
+
+    for (std::size_t phase_index = 0; phase_index < phases.size(); ++phase_index) {
+        const Phase& phase = phases[phase_index];
+        auto now = high_resolution_clock::now();
+
+        UringPass pass;
+        pass.fd = fd.get();
+        pass.total_ops = Config::IO_RANDOM_MAX_OPS;
+        pass.span_bytes = total_bytes;
+        pass.block_size = block_size;
+        pass.random_offsets = true;
+        pass.read_percent = phase.read_percent;
+        pass.queue_depth = queue_depth;
+        pass.write_buffer = write_mem;
+        pass.payload = &payload;
+        // The prefill is sequence 0; each phase stamps its rewrites with its own number.
+        pass.sequence = phase_index + 1;
+        pass.read_pool = read_mem;
+        pass.deadline = now + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+        pass.soft_deadline = now + seconds(Config::IO_RANDOM_PHASE_SECONDS);
+        histogram->reset();
+        pass.histogram = histogram.get();
+        pass.registration = registration;
+
+        auto res = run_uring_io(ring, pass, progress_cb, phase.label, stop);
+        if (!res)
+            return std::unexpected(res.error());
+
+        const double secs = res->elapsed.count();
+        DiskRandomPhaseResult phase_result;
+        phase_result.label = std::string(phase.label);
+        if (secs > 0) {
+            phase_result.iops = static_cast<double>(res->completed) / secs;
+            phase_result.mbps = static_cast<double>(res->bytes) / (1024.0 * 1024.0) / secs;
+        }
+        phase_result.latency = histogram->summarize();
+        result.phases.push_back(std::move(phase_result));
+    }
+#else
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+
+    return result;
+}
+
+std::expected<DiskSteadyStateResult, std::string> DiskBenchmark::run_steady_state_test(
+    int duration_s,
+    int file_size_mb,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
+    FileCleaner cleaner{filename};
+
+    duration_s = std::clamp(duration_s, 1, Config::IO_STEADY_MAX_DURATION_SECONDS);
+    const std::size_t block_size = Config::IO_WRITE_BLOCK_SIZE;
+    const int queue_depth = std::max(1, Config::IO_WRITE_QUEUE_DEPTH);
+    const std::uint64_t total_bytes =
+        std::max<std::uint64_t>(static_cast<std::uint64_t>(std::max(file_size_mb, 1)) * 1024 *
+                                    1024,
+                                block_size);
+
+    if (!is_disk_space_available(std::filesystem::current_path(), total_bytes)) {
+        return std::unexpected("Insufficient free space for steady-state test (needs " +
+                               format_bytes(total_bytes) + ")");
+    }
+
+    const std::size_t pool_size = static_cast<std::size_t>(queue_depth) * block_size;
+    auto buffer_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+    if (!buffer_res) {
+        return std::unexpected(buffer_res.error());
+    }
+    auto buffer = std::move(buffer_res.value());
+    auto write_mem = std::span{buffer.get(), pool_size};
+    optimize_memory_region(write_mem);
+    const PayloadGenerator payload{options.compressible_percent};
+
+    auto read_pool_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+    if (!read_pool_res) {
+        return std::unexpected(read_pool_res.error());
+    }
+    auto read_pool = std::move(read_pool_res.value());
+    auto read_mem = std::span{read_pool.get(), pool_size};
+    optimize_memory_region(read_mem);
+
+    // The series is sized up front so the completion loop only ever increments a counter.
+    const auto sample_interval = milliseconds(Config::IO_STEADY_SAMPLE_MS);
+    const auto sample_count = static_cast<std::size_t>(
+        duration_cast<milliseconds>(seconds(duration_s)) / sample_interval);
+    std::vector<std::uint64_t> interval_bytes(std::max<std::size_t>(1, sample_count));
+
+    DiskSteadyStateResult result;
+    result.file_size = total_bytes;
+    result.duration_seconds = duration_s;
+
+#ifdef USE_IO_URING
+    auto [fd, success_mode] =
+        open_benchmark_file(filename, O_RDWR | O_CREAT | O_TRUNC | O_EXCL, 0600);
+    if (!fd) {
+        return std::unexpected(get_error_message(errno, "create"));
+    }
+    print_storage_warning(success_mode, false);
+
+    int prealloc_rc = ::posix_fallocate(fd.get(), 0, static_cast<off_t>(total_bytes));
+    if (prealloc_rc != 0 && prealloc_rc != EINVAL && prealloc_rc != ENOTSUP) {
+        return std::unexpected(
+            std::format("Preallocation failed: {}", std::system_category().message(prealloc_rc)));
+    }
+
+    std::uint64_t written_bytes = 0;
+    std::array<std::string, 2> io_paths;
+
+    for (int read_percent : {0, 100}) {
+        const bool is_write = read_percent == 0;
+        const std::string_view label = is_write ? " Steady Write" : " Steady Read";
+
+        // Reads only cover what the write phase actually reached; the rest of the file is
+        // unwritten extents that would read back as zeros at memory speed.
+        const std::uint64_t span_bytes =
+            is_write ? total_bytes
+                     : std::min(total_bytes, written_bytes) / block_size * block_size;
+        if (span_bytes == 0) {
+            return std::unexpected("Steady-state write phase completed no I/O");
+        }
+
+        io_uring ring{};
+        auto setup = open_ring(ring,
+                               static_cast<unsigned>(queue_depth),
+                               options,
+                               fd.get(),
+                               is_write ? write_mem : read_mem);
+        if (!setup) {
+            return std::unexpected(setup.error());
+        }
+        RingGuard ring_guard{ring};
+
+        std::ranges::fill(interval_bytes, std::uint64_t{0});
+        auto now = high_resolution_clock::now();
+
+        UringPass pass;
+        pass.fd = fd.get();
+        pass.total_ops = std::numeric_limits<std::uint64_t>::max();
+        pass.span_bytes = span_bytes;
+        pass.block_size = block_size;
+        pass.wrap_offsets = true;
+        pass.read_percent = read_percent;
+        pass.queue_depth = queue_depth;
+        pass.write_buffer = write_mem;
+        pass.payload = &payload;
+        pass.read_pool = read_mem;
+        pass.soft_deadline = now + seconds(duration_s);
+        pass.deadline = pass.soft_deadline + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+        pass.registration = is_write ? register_uring_resources(ring, fd.get(), write_mem, {})
+                                     : register_uring_resources(ring, fd.get(), {}, read_mem);
+        pass.interval_bytes = interval_bytes;
+        pass.sample_interval = sample_interval;
+        io_paths[is_write ? 0 : 1] = describe_uring_path(*setup, pass.registration);
+
+        auto res = run_uring_io(ring, pass, progress_cb, label, stop);
+        if (!res)
+            return std::unexpected(res.error());
+
+        if (is_write) {
+            written_bytes = res->bytes;
+            if (::fdatasync(fd.get()) == -1) {
+                return std::unexpected("Disk sync failed: " + get_error_message(errno, "sync"));
+            }
+            ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+        }
+
+        const double interval_s = duration<double>(sample_interval).count();
+        DiskSteadyStatePhaseResult phase;
+        phase.label = std::string(label);
+        phase.sample_interval_ms = Config::IO_STEADY_SAMPLE_MS;
+        phase.series_mbps.reserve(interval_bytes.size());
+        for (std::uint64_t bytes : interval_bytes) {
+            phase.series_mbps.push_back(static_cast<double>(bytes) / (1024.0 * 1024.0) /
+                                        interval_s);
+        }
+        analyze_series(phase);
+        result.phases.push_back(std::move(phase));
+    }
+
+    result.io_path = io_paths[0] == io_paths[1]
+                         ? io_paths[0]
+                         : std::format("write: {}, read: {}", io_paths[0], io_paths[1]);
+#else
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+
+    return result;
+}
+
+std::expected<DiskColdReadResult, std::string> DiskBenchmark::run_cold_read_test(
+    double ram_multiple,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
+    FileCleaner cleaner{filename};
+
+    const std::size_t block_size = Config::IO_READ_BLOCK_SIZE;
+    const std::size_t region_size = Config::IO_COLD_REGION_BYTES;
+    const int queue_depth = std::max(1, Config::IO_READ_QUEUE_DEPTH);
+    ram_multiple = std::clamp(ram_multiple, 1.0, Config::IO_COLD_MAX_RAM_MULTIPLE);
+
+    DiskColdReadResult result;
+    result.ram_total = SystemInfo::get_memory_status().total;
+
+    std::error_code ec;
+    auto space = std::filesystem::space(std::filesystem::current_path(), ec);
+    if (ec) {
+        return std::unexpected("Cannot determine free space: " + ec.message());
+    }
+
+    const auto target =
+        static_cast<std::uint64_t>(static_cast<double>(result.ram_total) * ram_multiple);
+    const std::uint64_t space_cap =
+        space.available / 100 * static_cast<std::uint64_t>(Config::IO_COLD_MAX_SPACE_PERCENT);
+    result.space_limited = target > space_cap;
+    result.working_set = std::min(target, space_cap) / region_size * region_size;
+
+    const std::uint64_t min_working_set =
+        static_cast<std::uint64_t>(Config::IO_COLD_MIN_WORKING_SET_MB) * 1024 * 1024;
+    if (result.working_set < min_working_set) {
+        return std::unexpected("Insufficient free space for cold-read test (needs at least " +
+                               format_bytes(min_working_set) + ")");
+    }
+
+    // Only regions written at least one RAM's worth of data before the write finished are
+    // eligible: a cache no larger than RAM has had to evict them already.
+    const std::uint64_t eligible_bytes =
+        result.working_set > result.ram_total ? result.working_set - result.ram_total
+                                              : result.working_set / 2;
+    std::vector<std::uint64_t> regions(std::max<std::uint64_t>(1, eligible_bytes / region_size));
+    for (std::size_t i = 0; i < regions.size(); ++i) {
+        regions[i] = static_cast<std::uint64_t>(i) * region_size;
+    }
+    std::mt19937_64 shuffle_rng{std::random_device{}()};
+    std::ranges::shuffle(regions, shuffle_rng);
+    regions.resize(std::min<std::size_t>(
+        regions.size(),
+        std::max<std::size_t>(1, static_cast<std::size_t>(Config::IO_COLD_READ_BUDGET_BYTES /
+                                                          region_size))));
+    result.regions = regions.size();
+    result.bytes_read = static_cast<std::uint64_t>(regions.size()) * region_size;
+
+    const std::size_t read_pool_size = static_cast<std::size_t>(queue_depth) * block_size;
+    auto read_pool_res = make_aligned_buffer(read_pool_size, Config::IO_ALIGNMENT);
+    if (!read_pool_res) {
+        return std::unexpected(read_pool_res.error());
+    }
+    auto read_pool = std::move(read_pool_res.value());
+    auto read_mem = std::span{read_pool.get(), read_pool_size};
+    optimize_memory_region(read_mem);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+
+#ifdef USE_IO_URING
+    const PayloadGenerator payload{options.compressible_percent};
+    auto fd_res = prepare_test_file(
+        filename, result.working_set, payload, progress_cb, " Cold (Prepare)", stop);
+    if (!fd_res)
+        return std::unexpected(fd_res.error());
+    FileDescriptor fd = std::move(fd_res.value());
+
+    io_uring ring{};
+    auto setup = open_ring(ring, static_cast<unsigned>(queue_depth), options, fd.get(), read_mem);
+    if (!setup) {
+        return std::unexpected(setup.error());
+    }
+    RingGuard ring_guard{ring};
+
+    const UringRegistration registration = register_uring_resources(ring, fd.get(), {}, read_mem);
+    result.io_path = describe_uring_path(*setup, registration);
+
+    // One region at a time, sequential inside it. Progress counts regions. All regions of a
+    // pass share one DISK_BENCHMARK_MAX_SECONDS budget rather than a full one each.
+    auto read_regions = [&](std::string_view label) -> std::expected<double, std::string> {
+        histogram->reset();
+        const auto start = high_resolution_clock::now();
+        const auto deadline = start + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+
+        for (std::size_t i = 0; i < regions.size(); ++i) {
+            UringPass pass;
+            pass.fd = fd.get();
+            pass.total_ops = (region_size + block_size - 1) / block_size;
+            pass.span_bytes = region_size;
+            pass.base_offset = regions[i];
+            pass.block_size = block_size;
+            pass.read_percent = 100;
+            pass.queue_depth = queue_depth;
+            pass.read_pool = read_mem;
+            pass.deadline = deadline;
+            pass.histogram = histogram.get();
+            pass.verify = options.verify ? &payload : nullptr;
+            pass.registration = registration;
+
+            auto res = run_uring_io(ring, pass, {}, label, stop);
+            if (!res)
+                return std::unexpected(res.error());
+            if (progress_cb)
+                progress_cb(i + 1, regions.size(), label);
+        }
+
+        const duration<double> elapsed = high_resolution_clock::now() - start;
+        return elapsed.count() <= 0 ? 0.0
+                                    : static_cast<double>(result.bytes_read) /
+                                          (1024.0 * 1024.0) / elapsed.count();
+    };
+
+    auto cold = read_regions(" Cold Read");
+    if (!cold)
+        return std::unexpected(cold.error());
+    result.cold_mbps = *cold;
+    result.cold_latency = histogram->summarize();
+
+    auto warm = read_regions(" Warm Read");
+    if (!warm)
+        return std::unexpected(warm.error());
+    result.warm_mbps = *warm;
+    result.warm_latency = histogram->summarize();
+#else
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+
+    return result;
+}
+
+std::expected<DiskMetadataResult, std::string> DiskBenchmark::run_metadata_test(
+    int files,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto cwd = std::filesystem::current_path();
+    const std::filesystem::path root =
+        cwd / std::format("{}.{}.meta", Config::TEST_FILENAME, getpid());
+    DirectoryCleaner cleaner{root};
+
+    const auto file_count =
+        static_cast<std::size_t>(std::clamp(files, 1, Config::IO_META_MAX_FILES));
+    const int dir_count = std::max(1, Config::IO_META_DIRECTORIES);
+    const auto cpus = allowed_cpus();
+    const int thread_count = static_cast<int>(
+        std::min<std::size_t>({cpus.size(), file_count, Config::IO_META_MAX_THREADS}));
+
+    auto tree = make_test_tree(root, dir_count);
+    if (!tree)
+        return std::unexpected(tree.error());
+    const std::vector<FileDescriptor>& dir_fds = *tree;
+
+    // Thread t owns a contiguous run of files; consecutive files land in different
+    // directories so every thread touches all of them.
+    std::vector<MetaFile> meta_files(file_count);
+    for (std::size_t i = 0; i < file_count; ++i) {
+        meta_files[i].dir_fd = dir_fds[i % dir_fds.size()].get();
+        meta_files[i].name = std::format("f{}", i);
+        meta_files[i].renamed = std::format("r{}", i);
+    }
+
+    bool use_uring = false;
+#ifdef USE_IO_URING
+    use_uring = meta_uring_supported();
+#endif
+
+    DiskMetadataResult result;
+    result.files = file_count;
+    result.directories = dir_count;
+    result.threads = thread_count;
+    result.filesystem = SystemInfo::get_device_name(cwd.string());
+    result.io_path = use_uring ? std::format("io_uring OPENAT/CLOSE/STATX/RENAMEAT/UNLINKAT, QD{}",
+                                             Config::IO_META_QUEUE_DEPTH)
+                               : "syscalls (io_uring metadata ops unavailable)";
+
+    // The barrier completion stamps the start and end of every phase, so each phase is
+    // timed from the moment all threads begin to the moment the last one finishes.
+    std::array<high_resolution_clock::time_point, META_OPS.size() * 2> marks{};
+    std::atomic<std::size_t> mark_count{0};
+    std::barrier sync(thread_count, [&]() noexcept {
+        const auto index = mark_count.load(std::memory_order_relaxed);
+        if (index < marks.size())
+            marks[index] = high_resolution_clock::now();
+        mark_count.store(index + 1, std::memory_order_release);
+    });
+
+    std::array<std::atomic<std::uint64_t>, META_OPS.size()> phase_done{};
+    std::atomic<int> syscall_fallbacks{0};
+    std::mutex error_mutex;
+    std::string error;
+
+    run_pinned_workers(
+        cpus,
+        static_cast<std::size_t>(thread_count),
+        [&](std::size_t t) {
+            const std::size_t begin = file_count * t / static_cast<std::size_t>(thread_count);
+            const std::size_t end = file_count * (t + 1) / static_cast<std::size_t>(thread_count);
+            const auto mine = std::span<const MetaFile>(meta_files).subspan(begin, end - begin);
+
+            auto fail = [&](std::string message) {
+                std::scoped_lock lock(error_mutex);
+                if (error.empty())
+                    error = std::move(message);
+            };
+
+#ifdef USE_IO_URING
+            // A thread that cannot get a ring (RLIMIT_MEMLOCK, io_uring_disabled)
+            // runs its share through syscalls rather than failing the test.
+            io_uring ring{};
+            bool ring_ready = false;
+            if (use_uring) {
+                const auto entries = static_cast<unsigned>(Config::IO_META_QUEUE_DEPTH);
+                ring_ready = io_uring_queue_init(entries, &ring, 0) == 0;
+                if (!ring_ready)
+                    syscall_fallbacks.fetch_add(1, std::memory_order_relaxed);
+            }
+#endif
+
+            for (std::size_t p = 0; p < META_OPS.size(); ++p) {
+                sync.arrive_and_wait();
+                bool failed = false;
+                {
+                    std::scoped_lock lock(error_mutex);
+                    failed = !error.empty();
+                }
+                if (!failed) {
+                    std::expected<void, std::string> res;
+#ifdef USE_IO_URING
+                    if (ring_ready) {
+                        res = run_meta_uring(ring,
+                                             Config::IO_META_QUEUE_DEPTH,
+                                             META_OPS[p],
+                                             mine,
+                                             phase_done[p],
+                                             stop);
+                    } else
+#endif
+                    {
+                        res = run_meta_syscalls(META_OPS[p], mine, phase_done[p], stop);
+                    }
+                    if (!res)
+                        fail(res.error());
+                }
+                sync.arrive_and_wait();
+            }
+
+#ifdef USE_IO_URING
+            if (ring_ready)
+                io_uring_queue_exit(&ring);
+#endif
+        },
+        [&] {
+            const std::size_t phase =
+                std::min(mark_count.load(std::memory_order_acquire) / 2, META_OPS.size() - 1);
+            if (progress_cb) {
+                progress_cb(static_cast<std::size_t>(phase_done[phase].load()),
+                            file_count,
+                            std::format(" Metadata {}", meta_op_name(META_OPS[phase])));
+            }
+        });
+
+    if (!error.empty())
+        return std::unexpected(error);
+    if (g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+    if (const int fallbacks = syscall_fallbacks.load(); fallbacks > 0) {
+        result.io_path +=
+            std::format("; {} of {} threads on syscalls (no ring)", fallbacks, thread_count);
+    }
+
+    for (std::size_t p = 0; p < META_OPS.size(); ++p) {
+        DiskMetadataPhaseResult phase;
+        phase.op = std::string(meta_op_name(META_OPS[p]));
+        phase.ops = phase_done[p].load();
+        const duration<double> secs = marks[2 * p + 1] - marks[2 * p];
+        phase.ops_per_sec = secs.count() > 0 ? static_cast<double>(phase.ops) / secs.count() : 0.0;
+        result.phases.push_back(std::move(phase));
+    }
+    return result;
+}
+
+std::expected<DiskSmallFileResult, std::string> DiskBenchmark::run_small_file_test(
+    int files,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto cwd = std::filesystem::current_path();
+    const std::filesystem::path root =
+        cwd / std::format("{}.{}.small", Config::TEST_FILENAME, getpid());
+    DirectoryCleaner cleaner{root};
+
+    const auto file_count =
+        static_cast<std::size_t>(std::clamp(files, 1, Config::IO_SMALL_MAX_FILES));
+    const auto cpus = allowed_cpus();
+    const int thread_count = static_cast<int>(
+        std::min<std::size_t>({cpus.size(), file_count, Config::IO_SMALL_MAX_THREADS}));
+    constexpr std::size_t slot_bytes = Config::IO_SMALL_FILE_SIZES.back();
+    const auto depth = static_cast<std::size_t>(std::max(1, Config::IO_SMALL_QUEUE_DEPTH));
+
+    std::vector<SmallFile> small_files(file_count);
+    std::uint64_t total_bytes = 0;
+    XorShift64 rng{0x5DEECE66DULL ^ file_count};
+    for (std::size_t i = 0; i < file_count; ++i) {
+        small_files[i].name = std::format("s{}", i);
+        small_files[i].size =
+            Config::IO_SMALL_FILE_SIZES[rng.next() % Config::IO_SMALL_FILE_SIZES.size()];
+        small_files[i].index = i;
+        total_bytes += small_files[i].size;
+    }
+
+    if (!is_disk_space_available(cwd, total_bytes)) {
+        return std::unexpected("Insufficient free space for small-file test (needs " +
+                               format_bytes(total_bytes) + ")");
+    }
+
+    auto tree = make_test_tree(root, Config::IO_SMALL_DIRECTORIES);
+    if (!tree)
+        return std::unexpected(tree.error());
+    for (std::size_t i = 0; i < file_count; ++i)
+        small_files[i].dir_fd = (*tree)[i % tree->size()].get();
+
+    FileDescriptor root_fd(::open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!root_fd)
+        return std::unexpected(std::format("Cannot open {}", root.string()));
+
+    bool use_uring = false;
+#ifdef USE_IO_URING
+    use_uring = direct_open_supported();
+#endif
+
+    const PayloadGenerator payload{options.compressible_percent};
+
+    DiskSmallFileResult result;
+    result.files = file_count;
+    result.total_bytes = total_bytes;
+    result.threads = thread_count;
+    result.filesystem = SystemInfo::get_device_name(cwd.string());
+    result.io_path = use_uring
+                         ? std::format("io_uring linked OPENAT_DIRECT->WRITE/READ->CLOSE, QD{}",
+                                       depth)
+                         : "syscalls (io_uring direct descriptors unavailable)";
+
+    // Marks: write start, write end (after syncfs), read start, read end.
+    std::array<high_resolution_clock::time_point, 4> marks{};
+    std::atomic<std::size_t> mark_count{0};
+    std::barrier sync(thread_count, [&]() noexcept {
+        const auto index = mark_count.load(std::memory_order_relaxed);
+        if (index == 1)
+            ::syncfs(root_fd.get());
+        if (index < marks.size())
+            marks[index] = high_resolution_clock::now();
+        mark_count.store(index + 1, std::memory_order_release);
+    });
+
+    std::array<std::atomic<std::uint64_t>, 2> phase_done{};
+    std::mutex error_mutex;
+    std::string error;
+
+    run_pinned_workers(
+        cpus,
+        static_cast<std::size_t>(thread_count),
+        [&](std::size_t t) {
+            const std::size_t begin = file_count * t / static_cast<std::size_t>(thread_count);
+            const std::size_t end = file_count * (t + 1) / static_cast<std::size_t>(thread_count);
+            const auto mine =
+                std::span<const SmallFile>(small_files).subspan(begin, end - begin);
+
+            auto fail = [&](std::string message) {
+                std::scoped_lock lock(error_mutex);
+                if (error.empty())
+                    error = std::move(message);
+            };
+            auto failed = [&] {
+                std::scoped_lock lock(error_mutex);
+                return !error.empty();
+            };
+
+            auto buffer_res = make_aligned_buffer(depth * slot_bytes, Config::IO_ALIGNMENT);
+            std::span<std::byte> buffers;
+            if (buffer_res)
+                buffers = std::span{buffer_res->get(), depth * slot_bytes};
+            else
+                fail(buffer_res.error());
+
+#ifdef USE_IO_URING
+            io_uring ring{};
+            bool ring_ready = false;
+            if (use_uring && !buffers.empty()) {
+                int rc = io_uring_queue_init(static_cast<unsigned>(depth * 3), &ring, 0);
+                if (rc == 0) {
+                    ring_ready = true;
+                    rc = io_uring_register_files_sparse(&ring, static_cast<unsigned>(depth));
+                }
+                if (rc != 0)
+                    fail(uring_error(rc, "setup"));
+            }
+#endif
+
+            auto run_phase = [&](bool write) {
+                if (failed())
+                    return;
+                auto& done = phase_done[write ? 0 : 1];
+                std::expected<void, std::string> res;
+#ifdef USE_IO_URING
+                if (ring_ready) {
+                    res = run_small_files_uring(ring,
+                                                static_cast<int>(depth),
+                                                write,
+                                                mine,
+                                                buffers,
+                                                payload,
+                                                done,
+                                                stop);
+                } else
+#endif
+                {
+                    res = run_small_files_syscalls(write, mine, buffers, payload, done, stop);
+                }
+                if (!res)
+                    fail(res.error());
+            };
+
+            sync.arrive_and_wait();
+            run_phase(true);
+            sync.arrive_and_wait();
+
+            // Untimed: drop this thread's files from the page cache so reads are cold.
+            for (const SmallFile& file : mine) {
+                FileDescriptor fd(
+                    ::openat(file.dir_fd, file.name.c_str(), O_RDONLY | O_CLOEXEC));
+                if (fd)
+                    ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+            }
+
+            sync.arrive_and_wait();
+            run_phase(false);
+            sync.arrive_and_wait();
+
+#ifdef USE_IO_URING
+            if (ring_ready)
+                io_uring_queue_exit(&ring);
+#endif
+        },
+        [&] {
+            const bool reading = mark_count.load(std::memory_order_acquire) >= 2;
+            if (progress_cb) {
+                progress_cb(static_cast<std::size_t>(phase_done[reading ? 1 : 0].load()),
+                            file_count,
+                            reading ? " Small Files Read" : " Small Files Write");
+            }
+        });
+
+    if (!error.empty())
+        return std::unexpected(error);
+    if (g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+
+    const double total_mb = static_cast<double>(total_bytes) / (1024.0 * 1024.0);
+    for (std::size_t p = 0; p < 2; ++p) {
+        DiskSmallFilePhaseResult phase;
+        phase.op = p == 0 ? "Write" : "Read";
+        const duration<double> secs = marks[2 * p + 1] - marks[2 * p];
+        if (secs.count() > 0) {
+            phase.files_per_sec = static_cast<double>(file_count) / secs.count();
+            phase.mbps = total_mb / secs.count();
+        }
+        result.phases.push_back(std::move(phase));
+    }
+    return result;
+}
+
+std::string_view DiskBenchmark::engine_name(DiskEngine engine) noexcept {
+    switch (engine) {
+        case DiskEngine::IoUringDirect:
+            return "uring-direct";
+        case DiskEngine::IoUringBuffered:
+            return "uring-buffered";
+        case DiskEngine::Psync:
+            return "psync";
+        case DiskEngine::Mmap:
+            return "mmap";
+    }
+    return "unknown";
+}
+
+std::optional<DiskEngine> DiskBenchmark::parse_engine(std::string_view name) noexcept {
+    for (DiskEngine engine : ALL_ENGINES) {
+        if (engine_name(engine) == name)
+            return engine;
+    }
+    return std::nullopt;
+}
+
+std::expected<DiskEngineComparisonResult, std::string> DiskBenchmark::run_engine_comparison(
+    std::span<const DiskEngine> engines,
+    int compressible_percent,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
+    FileCleaner cleaner{filename};
+
+    const std::size_t block_size = Config::IO_WRITE_BLOCK_SIZE;
+    const std::uint64_t total_bytes =
+        static_cast<std::uint64_t>(Config::IO_ENGINE_FILE_SIZE_MB) * 1024 * 1024;
+
+    if (!is_disk_space_available(std::filesystem::current_path(), total_bytes)) {
+        return std::unexpected("Insufficient free space for engine comparison (needs " +
+                               format_bytes(total_bytes) + ")");
+    }
+
+    const std::size_t pool_size =
+        static_cast<std::size_t>(
+            std::max({1, Config::IO_WRITE_QUEUE_DEPTH, Config::IO_READ_QUEUE_DEPTH})) *
+        block_size;
+    auto buffer_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+    if (!buffer_res) {
+        return std::unexpected(buffer_res.error());
+    }
+    auto buffer = std::move(buffer_res.value());
+    auto write_mem = std::span{buffer.get(), pool_size};
+    optimize_memory_region(write_mem);
+    fill_pattern(write_mem);
+    const PayloadGenerator payload{compressible_percent};
+
+    auto read_pool_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+    if (!read_pool_res) {
+        return std::unexpected(read_pool_res.error());
+    }
+    auto read_pool = std::move(read_pool_res.value());
+    auto read_mem = std::span{read_pool.get(), pool_size};
+    optimize_memory_region(read_mem);
+
+    {
+        FileDescriptor create_fd(
+            ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_EXCL, 0600));
+        if (!create_fd) {
+            return std::unexpected(get_error_message(errno, "create"));
+        }
+        int prealloc_rc = ::posix_fallocate(create_fd.get(), 0, static_cast<off_t>(total_bytes));
+        if (prealloc_rc != 0 && prealloc_rc != EINVAL && prealloc_rc != ENOTSUP) {
+            return std::unexpected(std::format("Preallocation failed: {}",
+                                               std::system_category().message(prealloc_rc)));
+        }
+    }
+
+    DiskEngineComparisonResult result;
+    result.file_size = total_bytes;
+
+    for (DiskEngine engine : engines) {
+        FileDescriptor fd;
+        if (engine == DiskEngine::IoUringDirect) {
+            auto [direct_fd, success_mode] = open_benchmark_file(filename, O_RDWR, 0);
+            print_storage_warning(success_mode, false);
+            fd = std::move(direct_fd);
+        } else {
+            fd = FileDescriptor(::open(filename.c_str(), O_RDWR));
+        }
+        if (!fd) {
+            return std::unexpected(get_error_message(errno, "open/read"));
+        }
+
+        DiskEngineResult entry;
+        entry.engine = std::string(engine_name(engine));
+        std::array<std::string, 2> io_paths;
+
+        for (bool write : {true, false}) {
+            // Every phase starts cold so buffered engines cannot read back what they
+            // just wrote from the page cache.
+            ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+
+            // The file already holds the earlier engines' data. Store faults on a shared
+            // mapping read each page in first, so mmap writes into a fresh sparse file.
+            if (engine == DiskEngine::Mmap && write &&
+                (::ftruncate(fd.get(), 0) == -1 ||
+                 ::ftruncate(fd.get(), static_cast<off_t>(total_bytes)) == -1)) {
+                return std::unexpected(std::format(
+                    "{}: {}", entry.engine, get_error_message(errno, "truncate")));
+            }
+
+            const std::string label =
+                std::format(" {} {}", entry.engine, write ? "Write" : "Read");
+            const auto phase_start = high_resolution_clock::now();
+
+            auto res = run_engine_io(engine,
+                                     fd.get(),
+                                     total_bytes,
+                                     write,
+                                     block_size,
+                                     write_mem,
+                                     read_mem,
+                                     payload,
+                                     io_paths[write ? 0 : 1],
+                                     progress_cb,
+                                     label,
+                                     stop);
+            if (!res)
+                return std::unexpected(std::format("{}: {}", entry.engine, res.error()));
+
+            const duration<double> elapsed = high_resolution_clock::now() - phase_start;
+            const double mbps = elapsed.count() <= 0
+                                    ? 0.0
+                                    : static_cast<double>(*res) / (1024.0 * 1024.0) /
+                                          elapsed.count();
+            (write ? entry.write_mbps : entry.read_mbps) = mbps;
+        }
+
+        entry.io_path = io_paths[0] == io_paths[1]
+                            ? io_paths[0]
+                            : std::format("write: {}, read: {}", io_paths[0], io_paths[1]);
+        result.engines.push_back(std::move(entry));
+    }
+
+    return result;
+}
+
+std::expected<DiskCommitResult, std::string> DiskBenchmark::run_commit_test(
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
+    FileCleaner cleaner{filename};
+
+    const std::size_t max_record = std::ranges::max(Config::IO_COMMIT_RECORD_SIZES);
+    const std::uint64_t wrap_bytes =
+        static_cast<std::uint64_t>(Config::IO_COMMIT_FILE_SIZE_MB) * 1024 * 1024;
+
+    if (!is_disk_space_available(std::filesystem::current_path(), wrap_bytes)) {
+        return std::unexpected("Insufficient free space for commit latency test (needs " +
+                               format_bytes(wrap_bytes) + ")");
+    }
+
+    auto buffer_res = make_aligned_buffer(max_record, Config::IO_ALIGNMENT);
+    if (!buffer_res) {
+        return std::unexpected(buffer_res.error());
+    }
+    auto buffer = std::move(buffer_res.value());
+    auto record_mem = std::span{buffer.get(), max_record};
+    fill_pattern(record_mem);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+    DiskCommitResult result;
+
+    // Databases write their log through the page cache and rely on fdatasync for
+    // durability, so the file is opened without O_DIRECT/O_DSYNC. It starts empty and
+    // grows, which is the append case a fresh WAL segment sees.
+    std::error_code ec;
+    std::filesystem::remove(filename, ec);
+
+    FileDescriptor fd(::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_EXCL, 0600));
+    if (!fd) {
+        return std::unexpected(get_error_message(errno, "create"));
+    }
+
+    auto sync_commit = [&](std::uint64_t offset,
+                           std::size_t len) -> std::expected<void, std::string> {
+        const auto pos = static_cast<off_t>(offset);
+        ssize_t n = ::pwrite(fd.get(), record_mem.data(), len, pos);
+        while (n < 0 && errno == EINTR && !g_interrupted) {
+            n = ::pwrite(fd.get(), record_mem.data(), len, pos);
+        }
+        if (n < 0 && errno == EINTR)
+            return std::unexpected(get_error_message(EINTR, "write"));
+        if (n < 0)
+            return std::unexpected("Disk Test failed: " + get_error_message(errno, "write"));
+        if (static_cast<std::size_t>(n) != len) {
+            return std::unexpected(std::format(
+                "Disk Test failed: Partial write (expected {} bytes, got {})", len, n));
+        }
+        int rc = ::fdatasync(fd.get());
+        while (rc == -1 && errno == EINTR && !g_interrupted) {
+            rc = ::fdatasync(fd.get());
+        }
+        if (rc == -1 && errno == EINTR)
+            return std::unexpected(get_error_message(EINTR, "sync"));
+        if (rc == -1)
+            return std::unexpected("Disk sync failed: " + get_error_message(errno, "sync"));
+        return {};
+    };
+
+    auto record_phase = [&](std::string_view method,
+                            std::size_t record_size,
+                            const CommitLoopStats& stats) {
+        DiskCommitPhaseResult phase;
+        phase.method = std::string(method);
+        phase.record_size = record_size;
+        if (stats.elapsed.count() > 0) {
+            phase.commits_per_sec = static_cast<double>(stats.commits) / stats.elapsed.count();
+        }
+        phase.latency = histogram->summarize();
+        result.phases.push_back(std::move(phase));
+    };
+
+    for (std::size_t record_size : Config::IO_COMMIT_RECORD_SIZES) {
+        if (::ftruncate(fd.get(), 0) == -1) {
+            return std::unexpected("Disk Test failed: " + get_error_message(errno, "truncate"));
+        }
+        histogram->reset();
+
+        const std::string label = std::format(" fsync {} psync", format_bytes(record_size));
+        auto stats = run_commit_loop(sync_commit,
+                                     record_size,
+                                     wrap_bytes,
+                                     seconds(Config::IO_COMMIT_PHASE_SECONDS),
+                                     *histogram,
+                                     progress_cb,
+                                     label,
+                                     stop);
+        if (!stats)
+            return std::unexpected(stats.error());
+        record_phase("pwrite + fdatasync", record_size, *stats);
+    }
+
+#ifdef USE_IO_URING
+    io_uring ring{};
+    int ret = io_uring_queue_init(2, &ring, 0);
+    if (ret != 0) {
+        return std::unexpected(
+            std::format("Skipped: io_uring feature not available (Kernel <= 5.4?). Error: {}",
+                        std::system_category().message(-ret)));
+    }
+    RingGuard ring_guard{ring};
+
+    // The FSYNC is linked behind the WRITE, so both go down in one submission and the
+    // sync only starts once the write has landed; a failed write cancels the sync.
+    auto uring_commit = [&](std::uint64_t offset,
+                            std::size_t len) -> std::expected<void, std::string> {
+        io_uring_sqe* write_sqe = io_uring_get_sqe(&ring);
+        io_uring_sqe* sync_sqe = io_uring_get_sqe(&ring);
+        if (!write_sqe || !sync_sqe)
+            return std::unexpected("Disk Test failed: io_uring submission queue full");
+
+        io_uring_prep_write(
+            write_sqe, fd.get(), record_mem.data(), static_cast<unsigned>(len), offset);
+        io_uring_sqe_set_flags(write_sqe, IOSQE_IO_LINK);
+        io_uring_sqe_set_data64(write_sqe, 0);
+        io_uring_prep_fsync(sync_sqe, fd.get(), IORING_FSYNC_DATASYNC);
+        io_uring_sqe_set_data64(sync_sqe, 1);
+
+        int rc = io_uring_submit_and_wait(&ring, 2);
+        while (rc == -EINTR && !g_interrupted) {
+            rc = io_uring_submit_and_wait(&ring, 2);
+        }
+        if (rc == -EINTR)
+            return std::unexpected(get_error_message(EINTR, "submit"));
+        if (rc < 0)
+            return std::unexpected(uring_error(rc, "submit"));
+
+        // Both completions are reaped even after Ctrl+C, so the ring is never torn down
+        // with the record's write or sync still in flight.
+        std::expected<void, std::string> outcome;
+        for (int reaped = 0; reaped < 2; ++reaped) {
+            io_uring_cqe* cqe = nullptr;
+            do {
+                rc = io_uring_wait_cqe(&ring, &cqe);
+            } while (rc == -EINTR);
+            if (rc < 0)
+                return std::unexpected(uring_error(rc, "wait"));
+
+            const bool is_write = io_uring_cqe_get_data64(cqe) == 0;
+            const int res = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+
+            if (!outcome)
+                continue;
+            if (res < 0 && res != -ECANCELED) {
+                outcome = std::unexpected("Disk Test failed: " +
+                                          get_error_message(-res, is_write ? "write" : "sync"));
+            } else if (is_write && res != static_cast<int>(len)) {
+                outcome = std::unexpected(std::format(
+                    "Disk Test failed: Partial write (expected {} bytes, got {})", len, res));
+            }
+        }
+        return outcome;
+    };
+
+    for (std::size_t record_size : Config::IO_COMMIT_RECORD_SIZES) {
+        if (::ftruncate(fd.get(), 0) == -1) {
+            return std::unexpected("Disk Test failed: " + get_error_message(errno, "truncate"));
+        }
+        histogram->reset();
+
+        const std::string label = std::format(" fsync {} uring", format_bytes(record_size));
+        auto stats = run_commit_loop(uring_commit,
+                                     record_size,
+                                     wrap_bytes,
+                                     seconds(Config::IO_COMMIT_PHASE_SECONDS),
+                                     *histogram,
+                                     progress_cb,
+                                     label,
+                                     stop);
+        if (!stats)
+            return std::unexpected(stats.error());
+        record_phase("io_uring WRITE -> FSYNC (linked)", record_size, *stats);
+    }
+#endif
+
+    return result;
+}
+
+std::expected<DiskSweepResult, std::string> DiskBenchmark::run_sweep_test(
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const std::string filename = std::format("{}.{}", Config::TEST_FILENAME, getpid());
+    FileCleaner cleaner{filename};
+
+    const std::size_t max_block_size = std::ranges::max(Config::IO_SWEEP_BLOCK_SIZES);
+    const int max_queue_depth = std::ranges::max(Config::IO_SWEEP_QUEUE_DEPTHS);
+    const std::uint64_t total_bytes =
+        static_cast<std::uint64_t>(Config::IO_SWEEP_FILE_SIZE_MB) * 1024 * 1024;
+
+    if (!is_disk_space_available(std::filesystem::current_path(), total_bytes)) {
+        return std::unexpected("Insufficient free space for disk sweep (needs " +
+                               format_bytes(total_bytes) + ")");
+    }
+
+    // One pool serves every cell: a cell borrows queue_depth * block_size bytes from the
+    // front of it. The pool is sized for the largest cell unless available memory says
+    // otherwise; cells that would need more in flight than the pool holds are skipped.
+    const std::size_t largest_cell = static_cast<std::size_t>(max_queue_depth) * max_block_size;
+    const auto available = SystemInfo::get_memory_status().available;
+    const auto budget = static_cast<std::size_t>(
+        available / 100 * Config::IO_SWEEP_MAX_MEMORY_PERCENT / max_block_size * max_block_size);
+    const std::size_t pool_size = std::max(std::min(largest_cell, budget), max_block_size);
+    auto pool_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+    if (!pool_res) {
+        return std::unexpected(pool_res.error());
+    }
+    auto pool = std::move(pool_res.value());
+    auto pool_mem = std::span{pool.get(), pool_size};
+    optimize_memory_region(pool_mem);
+    fill_pattern(pool_mem);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+
+    DiskSweepResult result;
+    result.queue_depths.assign(Config::IO_SWEEP_QUEUE_DEPTHS.begin(),
+                               Config::IO_SWEEP_QUEUE_DEPTHS.end());
+    result.block_sizes.assign(Config::IO_SWEEP_BLOCK_SIZES.begin(),
+                              Config::IO_SWEEP_BLOCK_SIZES.end());
+    result.cells.reserve(result.queue_depths.size() * result.block_sizes.size());
+    result.pool_bytes = pool_size;
+
+#ifdef USE_IO_URING
+    const PayloadGenerator payload{options.compressible_percent};
+    auto fd_res =
+        prepare_test_file(filename, total_bytes, payload, progress_cb, " Sweep (Prepare)", stop);
+    if (!fd_res)
+        return std::unexpected(fd_res.error());
+    FileDescriptor fd = std::move(fd_res.value());
+
+    io_uring ring{};
+    auto setup =
+        open_ring(ring, static_cast<unsigned>(max_queue_depth), options, fd.get(), pool_mem);
+    if (!setup) {
+        return std::unexpected(setup.error());
+    }
+    RingGuard ring_guard{ring};
+
+    const UringRegistration registration = register_uring_resources(ring, fd.get(), {}, pool_mem);
+    result.io_path = describe_uring_path(*setup, registration);
+
+    for (std::size_t block_size : result.block_sizes) {
+        for (int queue_depth : result.queue_depths) {
+            DiskSweepCell cell;
+            cell.queue_depth = queue_depth;
+            cell.block_size = block_size;
+
+            if (static_cast<std::size_t>(queue_depth) * block_size > pool_size ||
+                block_size > total_bytes) {
+                cell.skipped = true;
+                result.cells.push_back(cell);
+                continue;
+            }
+
+            const std::string label =
+                std::format(" Sweep {} QD{}", format_bytes(block_size), queue_depth);
+            auto now = high_resolution_clock::now();
+
+            UringPass pass;
+            pass.fd = fd.get();
+            pass.total_ops = std::numeric_limits<std::uint64_t>::max();
+            pass.span_bytes = total_bytes;
+            pass.block_size = block_size;
+            pass.random_offsets = true;
+            pass.read_percent = 100;
+            pass.queue_depth = queue_depth;
+            pass.read_pool = pool_mem;
+            pass.deadline = now + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+            pass.soft_deadline = now + seconds(Config::IO_SWEEP_CELL_SECONDS);
+            histogram->reset();
+            pass.histogram = histogram.get();
+            pass.registration = registration;
+
+            auto res = run_uring_io(ring, pass, progress_cb, label, stop);
+            if (!res)
+                return std::unexpected(res.error());
+
+            const double secs = res->elapsed.count();
+            if (secs > 0) {
+                cell.iops = static_cast<double>(res->completed) / secs;
+                cell.mbps = static_cast<double>(res->bytes) / (1024.0 * 1024.0) / secs;
+            }
+            cell.latency = histogram->summarize();
+            result.cells.push_back(cell);
+        }
+    }
+#else
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+
+    return result;
+}
+
+std::expected<DiskMultiJobResult, std::string> DiskBenchmark::run_multi_job_test(
+    int jobs,
+    const DiskTestOptions& options,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    jobs = std::clamp(jobs, 1, Config::IO_MULTI_JOB_MAX);
+    const auto job_count = static_cast<std::size_t>(jobs);
+
+    const std::size_t block_size = Config::IO_WRITE_BLOCK_SIZE;
+    const int queue_depth = std::max(1, Config::IO_MULTI_JOB_QUEUE_DEPTH);
+    const std::uint64_t job_bytes =
+        static_cast<std::uint64_t>(Config::IO_MULTI_JOB_FILE_SIZE_MB) * 1024 * 1024;
+    const std::uint64_t job_blocks = (job_bytes + block_size - 1) / block_size;
+
+    if (!is_disk_space_available(std::filesystem::current_path(), job_bytes * job_count)) {
+        return std::unexpected("Insufficient free space for multi-job disk test (needs " +
+                               format_bytes(job_bytes * job_count) + ")");
+    }
+
+    const std::vector<int> cpus = allowed_cpus();
+
+    struct JobState {
+        int cpu = -1;
+        std::string filename;
+        std::string error;
+        std::string io_path;
+        high_resolution_clock::time_point write_end;
+        high_resolution_clock::time_point read_end;
+        std::uint64_t write_bytes = 0;
+        std::uint64_t read_bytes = 0;
+    };
+
+    std::vector<JobState> states(job_count);
+    std::vector<FileCleaner> cleaners;
+    cleaners.reserve(job_count);
+    for (std::size_t i = 0; i < job_count; ++i) {
+        states[i].cpu = cpus[i % cpus.size()];
+        states[i].filename = std::format("{}.{}.{}", Config::TEST_FILENAME, getpid(), i);
+        cleaners.push_back(FileCleaner{states[i].filename});
+    }
+
+    // The completion step of each barrier phase stamps the common start time, so every
+    // job's throughput and the aggregate are measured from the same instant.
+    std::array<high_resolution_clock::time_point, 2> phase_start{};
+    std::size_t phase = 0;
+    auto on_phase = [&]() noexcept {
+        if (phase < phase_start.size())
+            phase_start[phase++] = high_resolution_clock::now();
+    };
+    std::barrier sync_point(static_cast<std::ptrdiff_t>(job_count), on_phase);
+
+#ifdef USE_IO_URING
+    auto job_main = [&](std::size_t index) {
+        JobState& state = states[index];
+        bool dropped = false;
+        auto fail = [&](std::string message) {
+            state.error = std::move(message);
+            if (!dropped) {
+                dropped = true;
+                sync_point.arrive_and_drop();
+            }
+        };
+
+        pin_current_thread(state.cpu);
+
+        // Only the first job drives the progress bar; concurrent redraws would interleave.
+        const auto& job_progress =
+            index == 0 ? progress_cb
+                       : std::function<void(std::size_t, std::size_t, std::string_view)>{};
+
+        auto pool_size = static_cast<std::size_t>(queue_depth) * block_size;
+        auto write_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+        auto pool_res = make_aligned_buffer(pool_size, Config::IO_ALIGNMENT);
+        if (!write_res || !pool_res) {
+            return fail(!write_res ? write_res.error() : pool_res.error());
+        }
+        auto write_mem = std::span{write_res.value().get(), pool_size};
+        auto read_mem = std::span{pool_res.value().get(), pool_size};
+        optimize_memory_region(write_mem);
+        optimize_memory_region(read_mem);
+        fill_pattern(read_mem);
+        // Per-job generator: a shared seed would give every job's file identical blocks.
+        const PayloadGenerator payload{options.compressible_percent};
+
+        auto [fd, success_mode] =
+            open_benchmark_file(state.filename, O_RDWR | O_CREAT | O_TRUNC | O_EXCL, 0600);
+        if (!fd) {
+            return fail(get_error_message(errno, "create"));
+        }
+        if (index == 0) {
+            print_storage_warning(success_mode, false);
+        }
+
+        int prealloc_rc = ::posix_fallocate(fd.get(), 0, static_cast<off_t>(job_bytes));
+        if (prealloc_rc != 0 && prealloc_rc != EINVAL && prealloc_rc != ENOTSUP) {
+            return fail(std::format("Preallocation failed: {}",
+                                    std::system_category().message(prealloc_rc)));
+        }
+
+        io_uring ring{};
+        auto setup =
+            open_ring(ring, static_cast<unsigned>(queue_depth), options, fd.get(), write_mem);
+        if (!setup) {
+            return fail(setup.error());
+        }
+        RingGuard ring_guard{ring};
+
+        UringPass pass;
+        pass.fd = fd.get();
+        pass.total_ops = job_blocks;
+        pass.span_bytes = job_bytes;
+        pass.block_size = block_size;
+        pass.queue_depth = queue_depth;
+        pass.write_buffer = write_mem;
+        pass.payload = &payload;
+        pass.read_pool = read_mem;
+        pass.registration = register_uring_resources(ring, fd.get(), write_mem, read_mem);
+        state.io_path = describe_uring_path(*setup, pass.registration);
+
+        sync_point.arrive_and_wait();
+        pass.deadline = high_resolution_clock::now() + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+        auto write_pass = run_uring_io(ring, pass, job_progress, " Multi-Job Write", stop);
+        if (!write_pass) {
+            return fail(write_pass.error());
+        }
+        if (::fdatasync(fd.get()) == -1) {
+            return fail("Disk sync failed: " + get_error_message(errno, "sync"));
+        }
+        state.write_end = high_resolution_clock::now();
+        state.write_bytes = write_pass->bytes;
+        ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+
+        sync_point.arrive_and_wait();
+        pass.read_percent = 100;
+        pass.deadline = high_resolution_clock::now() + seconds(Config::DISK_BENCHMARK_MAX_SECONDS);
+        auto read_pass = run_uring_io(ring, pass, job_progress, " Multi-Job Read", stop);
+        if (!read_pass) {
+            return fail(read_pass.error());
+        }
+        state.read_end = high_resolution_clock::now();
+        state.read_bytes = read_pass->bytes;
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(job_count);
+        for (std::size_t i = 0; i < job_count; ++i) {
+            workers.emplace_back(job_main, i);
+        }
+    }
+#else
+    return std::unexpected("Skipped: Binary compiled without io_uring support. Cannot benchmark.");
+#endif
+
+    for (std::size_t i = 0; i < job_count; ++i) {
+        if (!states[i].error.empty()) {
+            return std::unexpected(std::format("Job #{}: {}", i + 1, states[i].error));
+        }
+    }
+
+    DiskMultiJobResult result;
+    result.io_path = states.front().io_path;
+    result.jobs.reserve(job_count);
+
+    high_resolution_clock::time_point last_write_end = phase_start[0];
+    high_resolution_clock::time_point last_read_end = phase_start[1];
+    std::uint64_t written_bytes = 0;
+    std::uint64_t read_bytes = 0;
+
+    auto mbps = [](std::uint64_t bytes, duration<double> elapsed) {
+        return elapsed.count() <= 0
+                   ? 0.0
+                   : static_cast<double>(bytes) / (1024.0 * 1024.0) / elapsed.count();
+    };
+
+    for (std::size_t i = 0; i < job_count; ++i) {
+        const JobState& state = states[i];
+        DiskJobResult job;
+        job.cpu = state.cpu;
+        job.write_mbps = mbps(state.write_bytes, state.write_end - phase_start[0]);
+        job.read_mbps = mbps(state.read_bytes, state.read_end - phase_start[1]);
+        result.jobs.push_back(job);
+
+        last_write_end = std::max(last_write_end, state.write_end);
+        last_read_end = std::max(last_read_end, state.read_end);
+        written_bytes += state.write_bytes;
+        read_bytes += state.read_bytes;
+    }
+
+    result.aggregate_write_mbps = mbps(written_bytes, last_write_end - phase_start[0]);
+    result.aggregate_read_mbps = mbps(read_bytes, last_read_end - phase_start[1]);
+
+    // Jain's fairness index: 1.0 when every job got the same share, 1/n when one job
+    // got everything.
+    auto jain = [&](auto member) {
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (const auto& job : result.jobs) {
+            sum += job.*member;
+            sum_sq += job.*member * job.*member;
+        }
+        return sum_sq <= 0 ? 0.0 : (sum * sum) / (static_cast<double>(job_count) * sum_sq);
+    };
+    result.write_fairness = jain(&DiskJobResult::write_mbps);
+    result.read_fairness = jain(&DiskJobResult::read_mbps);
 
-    return DiskIORunResult{std::string(label), write_speed, read_speed};
+    return result;
 }
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "include/payload_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <random>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t LANES = 4;
+constexpr std::size_t CHUNK = LANES * sizeof(std::uint64_t);
+
+struct SectorStamp {
+    std::uint64_t offset;
+    std::uint64_t seed;
+    std::uint64_t sequence;
+};
+constexpr std::size_t STAMP_SIZE = sizeof(SectorStamp);
+
+[[nodiscard]] constexpr std::uint64_t splitmix64(std::uint64_t& state) noexcept {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+// Four independent xoshiro256++ streams kept structure-of-arrays so the compiler can
+// step all lanes in one vector register (AVX2 on x86-64-v3 builds).
+struct Xoshiro256x4 {
+    alignas(32) std::array<std::uint64_t, LANES> s0;
+    alignas(32) std::array<std::uint64_t, LANES> s1;
+    alignas(32) std::array<std::uint64_t, LANES> s2;
+    alignas(32) std::array<std::uint64_t, LANES> s3;
+
+    explicit Xoshiro256x4(std::uint64_t seed) noexcept {
+        for (std::size_t lane = 0; lane < LANES; ++lane) {
+            s0[lane] = splitmix64(seed);
+            s1[lane] = splitmix64(seed);
+            s2[lane] = splitmix64(seed);
+            s3[lane] = splitmix64(seed);
+        }
+    }
+
+    void next(std::array<std::uint64_t, LANES>& out) noexcept {
+        for (std::size_t lane = 0; lane < LANES; ++lane) {
+            out[lane] = std::rotl(s0[lane] + s3[lane], 23) + s0[lane];
+            const std::uint64_t t = s1[lane] << 17;
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= t;
+            s3[lane] = std::rotl(s3[lane], 45);
+        }
+    }
+};
+
+[[nodiscard]] std::uint64_t make_run_seed() {
+    std::random_device rd;
+    const auto now = static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd() ^ now ^
+           (static_cast<std::uint64_t>(::getpid()) << 48);
+}
+
+[[nodiscard]] std::uint64_t sector_seed(const SectorStamp& stamp) noexcept {
+    return stamp.seed ^ (stamp.offset * 0xD1342543DE82EF95) ^
+           (stamp.sequence * 0xAF251AF3B0F025B5);
+}
+
+// Walks the random part of one sector 32 bytes at a time and hands each piece to `sink`,
+// which either writes it out or compares against it. Stops early when sink returns false.
+template <typename Sink>
+bool for_each_random_chunk(const SectorStamp& stamp, std::size_t random_end, Sink&& sink) {
+    Xoshiro256x4 rng{sector_seed(stamp)};
+    std::array<std::uint64_t, LANES> words{};
+
+    for (std::size_t cursor = STAMP_SIZE; cursor < random_end; cursor += CHUNK) {
+        rng.next(words);
+        if (!sink(cursor, words.data(), std::min(CHUNK, random_end - cursor)))
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+PayloadGenerator::PayloadGenerator(int compressible_percent)
+    : seed_(make_run_seed()),
+      compressible_percent_(std::clamp(compressible_percent, 0, 100)),
+      random_bytes_(std::max(STAMP_SIZE,
+                             SECTOR_SIZE * static_cast<std::size_t>(100 - compressible_percent_) /
+                                 100)) {}
+
+void PayloadGenerator::fill(std::span<std::byte> block,
+                            std::uint64_t offset,
+                            std::uint64_t sequence) const noexcept {
+    for (std::size_t pos = 0; pos < block.size(); pos += SECTOR_SIZE) {
+        std::byte* sector = block.data() + pos;
+        const std::size_t sector_len = std::min(SECTOR_SIZE, block.size() - pos);
+        const SectorStamp stamp{offset + pos, seed_, sequence};
+
+        std::memcpy(sector, &stamp, std::min(STAMP_SIZE, sector_len));
+        if (sector_len <= STAMP_SIZE)
+            continue;
+
+        const std::size_t random_end = std::min(random_bytes_, sector_len);
+        for_each_random_chunk(
+            stamp, random_end, [&](std::size_t cursor, const std::uint64_t* words, std::size_t n) {
+                std::memcpy(sector + cursor, words, n);
+                return true;
+            });
+        std::memset(sector + random_end, 0, sector_len - random_end);
+    }
+}
+
+std::expected<void, std::string> PayloadGenerator::verify(std::span<const std::byte> block,
+                                                          std::uint64_t offset,
+                                                          std::uint64_t sequence) const {
+    for (std::size_t pos = 0; pos < block.size(); pos += SECTOR_SIZE) {
+        const std::byte* sector = block.data() + pos;
+        const std::size_t sector_len = std::min(SECTOR_SIZE, block.size() - pos);
+        const SectorStamp expected{offset + pos, seed_, sequence};
+
+        SectorStamp found{};
+        std::memcpy(&found, sector, std::min(STAMP_SIZE, sector_len));
+        if (sector_len < STAMP_SIZE)
+            continue;
+
+        if (found.seed != expected.seed) {
+            return std::unexpected(
+                std::format("sector at offset {} holds data from another run", expected.offset));
+        }
+        if (found.offset != expected.offset) {
+            return std::unexpected(std::format(
+                "sector at offset {} holds data written for offset {} (misdirected I/O)",
+                expected.offset,
+                found.offset));
+        }
+        if (found.sequence != expected.sequence) {
+            return std::unexpected(
+                std::format("sector at offset {} holds write #{} instead of #{} (lost write)",
+                            expected.offset,
+                            found.sequence,
+                            expected.sequence));
+        }
+
+        const std::size_t random_end = std::min(random_bytes_, sector_len);
+        const bool body_ok = for_each_random_chunk(
+            expected,
+            random_end,
+            [&](std::size_t cursor, const std::uint64_t* words, std::size_t n) {
+                return std::memcmp(sector + cursor, words, n) == 0;
+            });
+        static constexpr std::array<std::byte, SECTOR_SIZE> zeros{};
+        const bool tail_ok =
+            std::memcmp(sector + random_end, zeros.data(), sector_len - random_end) == 0;
+        if (!body_ok || !tail_ok) {
+            return std::unexpected(
+                std::format("sector at offset {} is corrupted", expected.offset));
+        }
+    }
+    return {};
+}
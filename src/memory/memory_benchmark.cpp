@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "include/memory_benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "include/affinity.hpp"
+#include "include/config.hpp"
+#include "include/interrupts.hpp"
+#include "include/memory_region.hpp"
+#include "include/system_info.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+// Slices start on a cache line so no two threads ever write the same one.
+constexpr std::size_t SLICE_ALIGN_ELEMENTS = 64 / sizeof(double);
+
+struct StreamArrays {
+    AlignedBuffer a;
+    AlignedBuffer b;
+    AlignedBuffer c;
+    std::size_t elements = 0;
+};
+
+std::size_t kernel_index(StreamKernel kernel) noexcept {
+    return static_cast<std::size_t>(std::ranges::find(MemoryBenchmark::ALL_KERNELS, kernel) -
+                                    MemoryBenchmark::ALL_KERNELS.begin());
+}
+
+std::size_t bytes_per_element(StreamKernel kernel) noexcept {
+    switch (kernel) {
+        case StreamKernel::Copy:
+        case StreamKernel::Scale:
+            return 2 * sizeof(double);
+        case StreamKernel::Add:
+        case StreamKernel::Triad:
+            return 3 * sizeof(double);
+    }
+    return 0;
+}
+
+// Plain loops over restrict pointers: at -O3 with the build's -march these vectorise to
+// full-width loads and stores, which is all STREAM asks of the compiler.
+void run_kernel_slice(StreamKernel kernel,
+                      double* __restrict a,
+                      double* __restrict b,
+                      double* __restrict c,
+                      std::size_t n) noexcept {
+    constexpr double q = Config::MEM_STREAM_SCALAR;
+    switch (kernel) {
+        case StreamKernel::Copy:
+            for (std::size_t i = 0; i < n; ++i)
+                c[i] = a[i];
+            break;
+        case StreamKernel::Scale:
+            for (std::size_t i = 0; i < n; ++i)
+                b[i] = q * c[i];
+            break;
+        case StreamKernel::Add:
+            for (std::size_t i = 0; i < n; ++i)
+                c[i] = a[i] + b[i];
+            break;
+        case StreamKernel::Triad:
+            for (std::size_t i = 0; i < n; ++i)
+                a[i] = b[i] + q * c[i];
+            break;
+    }
+}
+
+// Four times the largest cache, clamped to the configured range, then cut down until all
+// three arrays fit in the allowed share of available memory.
+std::expected<std::size_t, std::string> pick_array_bytes() {
+    std::uint64_t largest_cache = 0;
+    for (const auto& cache : SystemInfo::get_cpu_caches())
+        largest_cache = std::max(largest_cache, cache.size);
+
+    std::size_t bytes = std::clamp(static_cast<std::size_t>(largest_cache * 4),
+                                   Config::MEM_STREAM_MIN_ARRAY_BYTES,
+                                   Config::MEM_STREAM_MAX_ARRAY_BYTES);
+
+    const auto available = SystemInfo::get_memory_status().available;
+    const auto budget =
+        static_cast<std::size_t>(available / 100 * Config::MEM_STREAM_MAX_MEMORY_PERCENT / 3);
+    bytes = std::min(bytes, budget) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+    if (bytes < Config::MEM_STREAM_MIN_ARRAY_BYTES) {
+        return std::unexpected(
+            std::format("Not enough free memory for three {} MiB arrays",
+                        Config::MEM_STREAM_MIN_ARRAY_BYTES / (1024 * 1024)));
+    }
+    return bytes;
+}
+
+std::expected<StreamArrays, std::string> allocate_arrays(std::size_t bytes) {
+    StreamArrays arrays;
+    for (AlignedBuffer* buffer : {&arrays.a, &arrays.b, &arrays.c}) {
+        auto allocated = make_aligned_buffer(bytes, HUGE_PAGE_SIZE);
+        if (!allocated)
+            return std::unexpected(allocated.error());
+        *buffer = std::move(*allocated);
+        optimize_memory_region(std::span(buffer->get(), bytes));
+    }
+    arrays.elements = bytes / sizeof(double);
+    return arrays;
+}
+
+// Runs every kernel Config::MEM_STREAM_REPS times with one pinned thread per entry of
+// `cpus`, each owning a contiguous slice it first-touches itself so the pages land on its
+// own NUMA node. Returns the best GB/s of each kernel, in ALL_KERNELS order.
+std::expected<std::array<double, 4>, std::string> run_stream(
+    StreamArrays& arrays,
+    std::span<const int> cpus,
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto thread_count = static_cast<std::ptrdiff_t>(cpus.size());
+    const auto reps = static_cast<std::size_t>(std::max(1, Config::MEM_STREAM_REPS));
+    const std::size_t steps = reps * MemoryBenchmark::ALL_KERNELS.size();
+    const std::string label = std::format(" Memory Bandwidth ({}T)", thread_count);
+
+    // One mark before the first step and one after each: step s ran between marks s and
+    // s + 1, from the last thread in to the last thread out.
+    std::vector<high_resolution_clock::time_point> marks(steps + 1);
+    std::atomic<std::size_t> mark_count{0};
+    std::barrier sync(thread_count, [&]() noexcept {
+        const auto index = mark_count.load(std::memory_order_relaxed);
+        if (index < marks.size())
+            marks[index] = high_resolution_clock::now();
+        mark_count.store(index + 1, std::memory_order_release);
+    });
+
+    const std::size_t chunk =
+        arrays.elements / cpus.size() / SLICE_ALIGN_ELEMENTS * SLICE_ALIGN_ELEMENTS;
+    double* const a = reinterpret_cast<double*>(arrays.a.get());
+    double* const b = reinterpret_cast<double*>(arrays.b.get());
+    double* const c = reinterpret_cast<double*>(arrays.c.get());
+
+    std::atomic<bool> abort{false};
+    run_pinned_workers(
+        cpus,
+        cpus.size(),
+        [&](std::size_t t) {
+            const std::size_t begin = t * chunk;
+            const std::size_t n = t + 1 == cpus.size() ? arrays.elements - begin : chunk;
+            std::fill_n(a + begin, n, 1.0);
+            std::fill_n(b + begin, n, 2.0);
+            std::fill_n(c + begin, n, 0.0);
+
+            // Every thread arrives at every mark even after an abort, or the rest would
+            // wait on the barrier forever.
+            sync.arrive_and_wait();
+            for (std::size_t s = 0; s < steps; ++s) {
+                if (!abort.load(std::memory_order_relaxed)) {
+                    const StreamKernel kernel =
+                        MemoryBenchmark::ALL_KERNELS[s % MemoryBenchmark::ALL_KERNELS.size()];
+                    run_kernel_slice(kernel, a + begin, b + begin, c + begin, n);
+                }
+                sync.arrive_and_wait();
+            }
+        },
+        [&] {
+            if (g_interrupted || stop.stop_requested())
+                abort.store(true, std::memory_order_relaxed);
+            if (progress_cb) {
+                const auto marked = mark_count.load(std::memory_order_acquire);
+                progress_cb(marked > 0 ? marked - 1 : 0, steps, label);
+            }
+        });
+
+    if (abort.load() || g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+
+    std::array<double, 4> best{};
+    for (std::size_t s = 0; s < steps; ++s) {
+        const StreamKernel kernel =
+            MemoryBenchmark::ALL_KERNELS[s % MemoryBenchmark::ALL_KERNELS.size()];
+        const duration<double> secs = marks[s + 1] - marks[s];
+        if (secs.count() <= 0)
+            continue;
+        const double bytes = static_cast<double>(bytes_per_element(kernel) * arrays.elements);
+        auto& slot = best[kernel_index(kernel)];
+        slot = std::max(slot, bytes / secs.count() / 1e9);
+    }
+
+    return best;
+}
+
+constexpr std::size_t CACHE_LINE = 64;
+constexpr std::uint64_t CHASE_SEED = 0x243F6A8885A308D3ULL;
+
+// Keeps the final pointer of each chase alive so the loads cannot be dropped.
+void* volatile g_chase_sink = nullptr;
+
+// Links the first `lines` cache lines of `base` into a single random cycle (Sattolo's
+// shuffle), each line holding the address of the next. Random order defeats the
+// prefetchers, and the walk touches a new page at almost every step once the set
+// outgrows the TLB.
+void build_chain(std::byte* base, std::size_t lines, std::vector<std::uint32_t>& order) {
+    order.resize(lines);
+    std::iota(order.begin(), order.end(), 0u);
+    std::mt19937_64 rng(CHASE_SEED ^ lines);
+    for (std::size_t i = lines - 1; i > 0; --i)
+        std::swap(order[i], order[rng() % i]);
+
+    for (std::size_t i = 0; i < lines; ++i)
+        *reinterpret_cast<std::byte**>(base + i * CACHE_LINE) = base + order[i] * CACHE_LINE;
+}
+
+// Nanoseconds per dependent load over Config::MEM_LATENCY_ACCESSES steps, after one
+// untimed lap (or as many steps) to fill the caches and TLB.
+double chase_ns(std::byte* base, std::size_t lines) {
+    constexpr std::size_t UNROLL = 16;
+    void* p = base;
+    for (std::size_t i = 0; i < std::min(lines, Config::MEM_LATENCY_ACCESSES); ++i)
+        p = *static_cast<void**>(p);
+
+    const auto begin = high_resolution_clock::now();
+    for (std::size_t i = 0; i < Config::MEM_LATENCY_ACCESSES; i += UNROLL) {
+        for (std::size_t u = 0; u < UNROLL; ++u)
+            p = *static_cast<void**>(p);
+    }
+    const duration<double, std::nano> elapsed = high_resolution_clock::now() - begin;
+    g_chase_sink = p;
+    return elapsed.count() / static_cast<double>(Config::MEM_LATENCY_ACCESSES);
+}
+
+// Splits the huge-page curve into plateaus. A transition is a run of steps that each rise
+// by more than MEM_LATENCY_STEP_RATIO; one that rises by MEM_LATENCY_KNEE_RATIO overall
+// closes the level below it at the size just before the run.
+std::vector<MemoryLatencyLevel> detect_levels(const std::vector<MemoryLatencyPoint>& points,
+                                              int cpu) {
+    std::vector<MemoryLatencyLevel> levels;
+    if (points.empty())
+        return levels;
+
+    auto rises = [&](std::size_t i) {
+        return points[i].huge_page_ns > points[i - 1].huge_page_ns * Config::MEM_LATENCY_STEP_RATIO;
+    };
+
+    std::size_t i = 1;
+    while (i < points.size()) {
+        if (!rises(i)) {
+            ++i;
+            continue;
+        }
+        std::size_t end = i;
+        while (end < points.size() && rises(end))
+            ++end;
+        const auto& before = points[i - 1];
+        if (points[end - 1].huge_page_ns >= before.huge_page_ns * Config::MEM_LATENCY_KNEE_RATIO)
+            levels.push_back({"", before.size_bytes, before.huge_page_ns, 0});
+        i = end;
+    }
+    levels.push_back({"", points.back().size_bytes, points.back().huge_page_ns, 0});
+
+    // Name the plateaus after the caches of the CPU the sweep ran on. The last one is main
+    // memory once there is a cache level below it to tell it apart from and the sweep went
+    // past the largest cache sysfs reports; a sweep capped by free memory may never get
+    // there, and its last plateau is still a cache.
+    const auto caches = SystemInfo::get_cpu_caches(cpu);
+    std::uint64_t largest_cache = 0;
+    for (const auto& cache : caches) {
+        if (cache.type != "Instruction")
+            largest_cache = std::max(largest_cache, cache.size);
+    }
+    const bool reached_dram = points.back().size_bytes > largest_cache;
+    for (std::size_t l = 0; l < levels.size(); ++l) {
+        if (reached_dram && levels.size() > 1 && l + 1 == levels.size()) {
+            levels[l].name = "DRAM";
+            break;
+        }
+        const int level = static_cast<int>(l) + 1;
+        levels[l].name = std::format("L{}", level);
+        for (const auto& cache : caches) {
+            if (cache.level == level && cache.type != "Instruction")
+                levels[l].reported_bytes = cache.size;
+        }
+    }
+    return levels;
+}
+
+}  // namespace
+
+std::string_view MemoryBenchmark::kernel_name(StreamKernel kernel) noexcept {
+    switch (kernel) {
+        case StreamKernel::Copy:
+            return "Copy";
+        case StreamKernel::Scale:
+            return "Scale";
+        case StreamKernel::Add:
+            return "Add";
+        case StreamKernel::Triad:
+            return "Triad";
+    }
+    return "unknown";
+}
+
+std::string MemoryBenchmark::transparent_hugepage_mode() {
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    if (!std::getline(file, line))
+        return "unknown";
+    const auto open = line.find('[');
+    const auto close = line.find(']', open);
+    if (open == std::string::npos || close == std::string::npos)
+        return "unknown";
+    return line.substr(open + 1, close - open - 1);
+}
+
+std::expected<MemoryBandwidthResult, std::string> MemoryBenchmark::run_bandwidth_test(
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    auto array_bytes = pick_array_bytes();
+    if (!array_bytes)
+        return std::unexpected(array_bytes.error());
+
+    const auto cpus = allowed_cpus();
+    MemoryBandwidthResult result;
+    result.array_bytes = *array_bytes;
+    result.threads = static_cast<int>(cpus.size());
+    result.thp_mode = transparent_hugepage_mode();
+
+    // Fresh arrays per run, so the all-core run's pages are placed by its own threads
+    // rather than wherever the single-thread run first touched them.
+    auto run_on = [&](std::span<const int> run_cpus)
+        -> std::expected<std::array<double, 4>, std::string> {
+        auto arrays = allocate_arrays(*array_bytes);
+        if (!arrays)
+            return std::unexpected(arrays.error());
+        return run_stream(*arrays, run_cpus, progress_cb, stop);
+    };
+
+    auto single = run_on(std::span(cpus).first(1));
+    if (!single)
+        return std::unexpected(single.error());
+
+    // On one CPU the all-core run would only repeat the single-thread one.
+    auto multi = single;
+    if (cpus.size() > 1) {
+        multi = run_on(cpus);
+        if (!multi)
+            return std::unexpected(multi.error());
+    }
+
+    for (StreamKernel kernel : ALL_KERNELS) {
+        MemoryBandwidthKernelResult row;
+        row.name = std::string(kernel_name(kernel));
+        row.single_gbps = (*single)[kernel_index(kernel)];
+        row.multi_gbps = (*multi)[kernel_index(kernel)];
+        result.kernels.push_back(std::move(row));
+    }
+    return result;
+}
+
+std::expected<MemoryLatencyResult, std::string> MemoryBenchmark::run_latency_sweep(
+    const std::function<void(std::size_t, std::size_t, std::string_view)>& progress_cb,
+    std::stop_token stop) {
+    const auto available = SystemInfo::get_memory_status().available;
+    const auto budget =
+        static_cast<std::size_t>(available / 100 * Config::MEM_LATENCY_MAX_MEMORY_PERCENT);
+    const std::size_t max_bytes = std::min(Config::MEM_LATENCY_MAX_BYTES, std::bit_floor(budget));
+    if (max_bytes < Config::MEM_LATENCY_MIN_BYTES)
+        return std::unexpected("Not enough free memory for the latency sweep");
+
+    std::vector<std::size_t> sizes;
+    for (std::size_t size = Config::MEM_LATENCY_MIN_BYTES; size <= max_bytes; size *= 2)
+        sizes.push_back(size);
+
+    const auto cpus = allowed_cpus();
+    MemoryLatencyResult result;
+    result.cpu = cpus.front();
+    result.thp_mode = transparent_hugepage_mode();
+    result.points.resize(sizes.size());
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+        result.points[i].size_bytes = sizes[i];
+
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> abort{false};
+    std::string error;
+    const std::size_t total = sizes.size() * 2;
+    run_pinned_workers(
+        std::span(&result.cpu, 1),
+        1,
+        [&](std::size_t) {
+            std::vector<std::uint32_t> order;
+            for (bool huge : {true, false}) {
+                // A fresh buffer per pass: the advice only applies to pages not yet faulted.
+                auto buffer = make_aligned_buffer(max_bytes, HUGE_PAGE_SIZE);
+                if (!buffer) {
+                    error = buffer.error();
+                    break;
+                }
+                const std::span region(buffer->get(), max_bytes);
+                if (huge)
+                    optimize_memory_region(region);
+                else
+                    use_small_pages(region);
+
+                for (auto& point : result.points) {
+                    if (abort.load(std::memory_order_relaxed))
+                        break;
+                    const std::size_t lines = point.size_bytes / CACHE_LINE;
+                    build_chain(buffer->get(), lines, order);
+                    (huge ? point.huge_page_ns : point.small_page_ns) =
+                        chase_ns(buffer->get(), lines);
+                    done.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        },
+        [&] {
+            if (g_interrupted || stop.stop_requested())
+                abort.store(true, std::memory_order_relaxed);
+            if (progress_cb)
+                progress_cb(done.load(std::memory_order_relaxed), total, " Memory Latency");
+        });
+
+    if (abort.load() || g_interrupted || stop.stop_requested())
+        return std::unexpected("Operation interrupted by user");
+    if (!error.empty())
+        return std::unexpected(error);
+
+    result.levels = detect_levels(result.points, result.cpu);
+    return result;
+}
@@ -274,10 +274,17 @@ void SpeedTest::install() {
         });
 }
 
-SpeedTestResult SpeedTest::run(const SpinnerCallback& spinner_cb) {
+SpeedTestResult SpeedTest::run(const SpinnerCallback& spinner_cb,
+                               const SpeedEntryCallback& entry_cb) {
     SpeedTestResult result;
     result.entries.reserve(SERVERS.size());
 
+    auto record = [&](const SpeedEntryResult& entry) {
+        result.entries.push_back(entry);
+        if (entry_cb)
+            entry_cb(entry);
+    };
+
     // Use std::span for safer access to embedded cert
     auto cert_expected = ScopedCertFile::create(base_dir_, std::span{cacert_pem, cacert_pem_len});
 
@@ -286,7 +293,7 @@ SpeedTestResult SpeedTest::run(const SpinnerCallback& spinner_cb) {
         entry.node_name = "System Error";
         entry.error = "Certificate Error: " + cert_expected.error();
         entry.success = false;
-        result.entries.push_back(entry);
+        record(entry);
         return result;
     }
 
@@ -319,7 +326,7 @@ SpeedTestResult SpeedTest::run(const SpinnerCallback& spinner_cb) {
             if (g_interrupted) {
                 entry.success = false;
                 entry.error = "Interrupted by user";
-                result.entries.push_back(entry);
+                record(entry);
                 break;
             }
 
@@ -418,7 +425,7 @@ SpeedTestResult SpeedTest::run(const SpinnerCallback& spinner_cb) {
             }
 
             if (entry.rate_limited) {
-                result.entries.push_back(entry);
+                record(entry);
                 return result;
             }
 
@@ -426,7 +433,7 @@ SpeedTestResult SpeedTest::run(const SpinnerCallback& spinner_cb) {
             entry.error = e.what();
             entry.success = false;
         }
-        result.entries.push_back(entry);
+        record(entry);
     }
 
     return result;
@@ -89,6 +89,8 @@ ShellPipe::ShellPipe(const std::vector<std::string>& args) {
 
         read_fd_.reset();
         write_fd.reset();
+        // --json ignores SIGPIPE in this process; the child gets the default back.
+        ::signal(SIGPIPE, SIG_DFL);
 
         ::execvp(c_args[0], c_args.data());
 
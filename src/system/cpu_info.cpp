@@ -16,9 +16,11 @@
 #include <fstream>
 #include <format>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #if defined(__i386__) || defined(__x86_64__)
 #include <cpuid.h>
@@ -100,6 +102,26 @@ bool cpu_has_flag(std::string_view flag) {
 }
 #endif
 
+// sysfs cache sizes look like "32K" or "32768K"; a bare number is in KB.
+std::optional<std::uint64_t> parse_cache_size(std::string_view s) {
+    std::string_view sv = trim_sv(s);
+    std::uint64_t size = 0;
+    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), size);
+    if (ec != std::errc() || sv.empty())
+        return std::nullopt;
+
+    if (ptr < sv.data() + sv.size()) {
+        char suffix = static_cast<char>(std::toupper(static_cast<unsigned char>(*ptr)));
+        if (suffix == 'K')
+            size *= 1024;
+        else if (suffix == 'M')
+            size *= 1024 * 1024;
+    } else {
+        size *= 1024;
+    }
+    return size;
+}
+
 }  // namespace
 
 std::string SystemInfo::get_model_name() {
@@ -199,22 +221,10 @@ std::string SystemInfo::get_cpu_cache() {
         if (sv.empty())
             return "Unknown";
 
-        uint64_t size = 0;
-        auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), size);
-
-        if (ec != std::errc())
+        auto parsed = parse_cache_size(sv);
+        if (!parsed)
             return std::string(sv);
-
-        if (ptr < sv.data() + sv.size()) {
-            char suffix = static_cast<char>(std::toupper(static_cast<unsigned char>(*ptr)));
-            if (suffix == 'K')
-                size *= 1024;
-            else if (suffix == 'M')
-                size *= 1024 * 1024;
-        } else {
-            // Sysfs value is in KB by default
-            size *= 1024;
-        }
+        const std::uint64_t size = *parsed;
 
         if (size >= 1024 * 1024)
             return std::format("{:.0f} MB", static_cast<double>(size) / (1024.0 * 1024.0));
@@ -264,4 +274,51 @@ bool SystemInfo::has_vmx() {
 #else
     return cpu_has_flag("vmx") || cpu_has_flag("svm");
 #endif
-}
\ No newline at end of file
+}
+
+std::vector<CpuTimes> SystemInfo::get_cpu_times() {
+    std::vector<CpuTimes> times;
+    std::ifstream stat("/proc/stat");
+    std::string line;
+    while (std::getline(stat, line)) {
+        if (!line.starts_with("cpu"))
+            break;  // the cpu lines come first
+
+        std::istringstream in(line);
+        std::string name;
+        CpuTimes t;
+        if (!(in >> name >> t.user >> t.nice >> t.system >> t.idle >> t.iowait >> t.irq >>
+              t.softirq))
+            continue;
+        in >> t.steal;  // absent before 2.6.11 and on some non-x86 kernels
+
+        if (name != "cpu") {
+            auto cpu = parse_number<int>(std::string_view(name).substr(3));
+            if (!cpu)
+                continue;
+            t.cpu = *cpu;
+        }
+        times.push_back(t);
+    }
+    return times;
+}
+
+std::vector<CpuCacheInfo> SystemInfo::get_cpu_caches(int cpu) {
+    std::vector<CpuCacheInfo> caches;
+    for (int index = 0;; ++index) {
+        const auto dir = std::format("/sys/devices/system/cpu/cpu{}/cache/index{}", cpu, index);
+        std::ifstream level_file(dir + "/level");
+        std::ifstream type_file(dir + "/type");
+        std::ifstream size_file(dir + "/size");
+        CpuCacheInfo cache;
+        std::string size;
+        if (!(level_file >> cache.level) || !(type_file >> cache.type) || !(size_file >> size))
+            break;
+        auto bytes = parse_cache_size(size);
+        if (!bytes)
+            continue;
+        cache.size = *bytes;
+        caches.push_back(std::move(cache));
+    }
+    return caches;
+}
@@ -12,7 +12,9 @@
 #include <cctype>
 #include <charconv>
 #include <expected>
+#include <filesystem>
 #include <fstream>
+#include <optional>
 #include <sstream>
 #include <format>
 #include <ranges>
@@ -24,6 +26,149 @@
 #include <sys/statvfs.h>
 #include <sys/sysinfo.h>
 #include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace {
+
+// One /proc/self/mountinfo record, e.g.
+// 36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 - ext3 /dev/root rw,errors=continue
+// (0)ID (1)Parent (2)Maj:Min (3)Root (4)MountPoint (5)Options ... - FSType Source
+// Views point into the line they were parsed from.
+struct MountInfoLine {
+    std::string_view major_minor;
+    std::string_view mount_point;
+    std::string_view mount_options;
+    std::string_view fs_type;
+    std::string_view source;
+};
+
+std::optional<MountInfoLine> parse_mountinfo_line(std::string_view line) {
+    // C++23: Clean tokenization
+    auto tokens_view = line | std::views::split(' ') |
+                       std::views::filter([](auto&& rng) { return !std::ranges::empty(rng); }) |
+                       std::views::transform([](auto&& rng) {
+                           return std::string_view(
+                               &*rng.begin(), static_cast<size_t>(std::ranges::distance(rng)));
+                       });
+
+    std::vector<std::string_view> tokens;
+    for (auto t : tokens_view)
+        tokens.push_back(t);
+
+    if (tokens.size() < 7)  // Min required to even reach the separator
+        return std::nullopt;
+
+    // Optional fields sit between Options and the "-" separator
+    auto separator_it = std::ranges::find(tokens, "-");
+    if (separator_it == tokens.end() || std::distance(separator_it, tokens.end()) < 3)
+        return std::nullopt;
+
+    return MountInfoLine{tokens[2], tokens[4], tokens[5], *(separator_it + 1), *(separator_it + 2)};
+}
+
+// The kernel writes space, tab, newline and backslash in mountinfo paths as three-digit
+// octal escapes ("/mnt/my\040disk"); anything else passes through unchanged.
+std::string unescape_mountinfo(std::string_view field) {
+    auto is_octal = [](char c) { return c >= '0' && c <= '7'; };
+
+    std::string out;
+    out.reserve(field.size());
+    for (std::size_t i = 0; i < field.size(); ++i) {
+        if (field[i] == '\\' && i + 3 < field.size() &&
+            std::ranges::all_of(field.substr(i + 1, 3), is_octal)) {
+            out.push_back(static_cast<char>((field[i + 1] - '0') * 64 +
+                                            (field[i + 2] - '0') * 8 + (field[i + 3] - '0')));
+            i += 3;
+            continue;
+        }
+        out.push_back(field[i]);
+    }
+    return out;
+}
+
+// Whole disks backing a block device: a partition resolves to its parent disk, and
+// device-mapper / md devices resolve through their slaves, so two LVs on one PV share a
+// disk. Falls back to the device itself when sysfs has nothing to say.
+std::vector<std::string> backing_disks(const std::filesystem::path& sys_dev, int depth = 0) {
+    std::error_code ec;
+    auto resolved = std::filesystem::canonical(sys_dev, ec);
+    if (ec)
+        return {};
+
+    if (std::filesystem::exists(resolved / "partition", ec))
+        resolved = resolved.parent_path();
+
+    std::vector<std::string> disks;
+    if (depth < 8) {
+        for (const auto& slave : std::filesystem::directory_iterator(resolved / "slaves", ec)) {
+            auto nested = backing_disks(slave.path(), depth + 1);
+            disks.insert(disks.end(), nested.begin(), nested.end());
+        }
+    }
+
+    if (disks.empty())
+        disks.push_back(resolved.filename().string());
+
+    std::ranges::sort(disks);
+    auto [first, last] = std::ranges::unique(disks);
+    disks.erase(first, last);
+    return disks;
+}
+
+struct MountMatch {
+    std::string source;
+    std::string fs_type;
+};
+
+// Mount that `path` lives on: the longest mount point that prefixes it, or failing that
+// the mount whose device number matches the path's.
+std::optional<MountMatch> find_mount(const std::string& path) {
+    struct stat st {};
+    if (stat(path.c_str(), &st) != 0)
+        return std::nullopt;
+
+    std::ifstream mountinfo("/proc/self/mountinfo");
+    if (!mountinfo)
+        return std::nullopt;
+
+    const std::string target_dev = std::format("{}:{}", major(st.st_dev), minor(st.st_dev));
+
+    std::optional<MountMatch> best_path_match;
+    size_t best_path_len = 0;
+
+    std::optional<MountMatch> exact_dev_match;
+
+    std::string line;
+    while (std::getline(mountinfo, line)) {
+        auto entry = parse_mountinfo_line(line);
+        if (!entry)
+            continue;
+
+        const std::string mount_point = unescape_mountinfo(entry->mount_point);
+        const std::string source = unescape_mountinfo(entry->source);
+        const std::string_view fs_type = entry->fs_type;
+
+        if (entry->major_minor == target_dev) {
+            exact_dev_match = MountMatch{source, std::string(fs_type)};
+        }
+
+        if (path.starts_with(mount_point)) {  // C++20 starts_with
+            bool valid_boundary = (path.size() == mount_point.size()) || (mount_point == "/") ||
+                                  (path[mount_point.size()] == '/');
+
+            if (valid_boundary && mount_point.size() > best_path_len) {
+                best_path_len = mount_point.size();
+                best_path_match = MountMatch{source, std::string(fs_type)};
+            }
+        }
+    }
+
+    if (best_path_match)
+        return best_path_match;
+    return exact_dev_match;
+}
+
+}  // namespace
 
 MemInfo SystemInfo::get_memory_status() {
     MemInfo info{};
@@ -143,84 +288,116 @@ std::vector<SwapEntry> SystemInfo::get_swaps() {
 }
 
 std::string SystemInfo::get_device_name(const std::string& path) {
-    struct stat st {};
-    if (stat(path.c_str(), &st) != 0)
+    auto mount = find_mount(path);
+    if (!mount)
         return "unknown device";
 
-    std::ifstream mountinfo("/proc/self/mountinfo");
-    if (!mountinfo)
-        return "unknown device";
+    if (mount->source == mount->fs_type)
+        return mount->source;
+    return std::format("{} ({})", mount->source, mount->fs_type);
+}
 
-    const std::string target_dev = std::format("{}:{}", major(st.st_dev), minor(st.st_dev));
+std::optional<std::string> SystemInfo::get_block_device(const std::string& path) {
+    struct stat st {};
+    if (stat(path.c_str(), &st) != 0)
+        return std::nullopt;
+
+    // Filesystems on a real device report it as st_dev; overlay and btrfs use anonymous
+    // device numbers, so fall back to the source of the mount get_device_name picks.
+    std::error_code ec;
+    auto sys_dev = std::filesystem::canonical(
+        std::format("/sys/dev/block/{}:{}", major(st.st_dev), minor(st.st_dev)), ec);
+    if (!ec)
+        return sys_dev.filename().string();
+
+    auto mount = find_mount(path);
+    if (!mount || !mount->source.starts_with("/dev/"))
+        return std::nullopt;
+
+    auto node = std::filesystem::canonical(mount->source, ec);
+    if (ec)
+        return std::nullopt;
+    return node.filename().string();
+}
 
-    std::string best_path_match = "unknown device";
-    size_t best_path_len = 0;
+std::optional<DiskStatSnapshot> SystemInfo::get_disk_stats(const std::string& device) {
+    // Field layout is shared by /sys/class/block/<dev>/stat and the tail of each
+    // /proc/diskstats line; see Documentation/admin-guide/iostats.rst.
+    auto parse = [](std::istream& in) -> std::optional<DiskStatSnapshot> {
+        DiskStatSnapshot s;
+        if (!(in >> s.reads >> s.reads_merged >> s.sectors_read >> s.read_ticks_ms >> s.writes >>
+              s.writes_merged >> s.sectors_written >> s.write_ticks_ms >> s.in_flight >>
+              s.io_ticks_ms >> s.queue_ticks_ms))
+            return std::nullopt;
+        return s;
+    };
+
+    std::ifstream sys_stat(std::format("/sys/class/block/{}/stat", device));
+    if (sys_stat) {
+        if (auto snapshot = parse(sys_stat))
+            return snapshot;
+    }
 
-    std::string exact_dev_match;
+    // sysfs is often absent in containers while /proc/diskstats is not.
+    std::ifstream diskstats("/proc/diskstats");
+    std::string line;
+    while (std::getline(diskstats, line)) {
+        std::istringstream in(line);
+        unsigned major_number = 0;
+        unsigned minor_number = 0;
+        std::string name;
+        if (in >> major_number >> minor_number >> name && name == device)
+            return parse(in);
+    }
+    return std::nullopt;
+}
 
+std::vector<MountEntry> SystemInfo::get_writable_mounts() {
+    std::vector<MountEntry> mounts;
+    std::ifstream mountinfo("/proc/self/mountinfo");
     std::string line;
+
     while (std::getline(mountinfo, line)) {
-        // C++23: Clean tokenization
-        auto tokens_view = line | std::views::split(' ') |
-                           std::views::filter([](auto&& rng) { return !std::ranges::empty(rng); }) |
-                           std::views::transform([](auto&& rng) {
-                               return std::string_view(
-                                   &*rng.begin(), static_cast<size_t>(std::ranges::distance(rng)));
-                           });
-
-        // Convert to vector for indexed access (parsing the mountinfo structure)
-        // mountinfo structure is slightly variable but fields 0-4 are fixed
-        // 36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 - ext3 /dev/root rw,errors=continue
-        // (0)ID (1)Parent (2)Maj:Min (3)Root (4)MountPoint ... - (N)FSType (N+1)Source
-
-        std::vector<std::string_view> tokens;
-        for (auto t : tokens_view)
-            tokens.push_back(t);
-
-        if (tokens.size() < 7)  // Min required to even reach the separator
+        auto entry = parse_mountinfo_line(line);
+        if (!entry)
             continue;
 
-        std::string_view major_minor = tokens[2];
-        std::string_view mount_point = tokens[4];
-
-        // Find separator "-"
-        // It's optional fields between MountPoint and separator
-        auto separator_it = std::ranges::find(tokens, "-");
-        if (separator_it == tokens.end() || std::distance(separator_it, tokens.end()) < 3)
+        // Only real block devices mounted read-write; loop devices are images, not disks.
+        if (!entry->source.starts_with("/dev/") || entry->source.starts_with("/dev/loop"))
+            continue;
+        if (!entry->mount_options.starts_with("rw"))
             continue;
 
-        // FSType is after separator, Source is after FSType
-        std::string_view fs_type = *(separator_it + 1);
-        std::string_view source = *(separator_it + 2);
-
-        auto format_output = [&](std::string_view src, std::string_view fs) {
-            if (src == fs)
-                return std::string(src);
-            return std::format("{} ({})", src, fs);
-        };
+        // Bind mounts and btrfs subvolumes repeat a device. Only mount points this process
+        // can write to are candidates, and the shortest one stands for the device.
+        std::string mount_point = unescape_mountinfo(entry->mount_point);
+        if (::access(mount_point.c_str(), W_OK) != 0)
+            continue;
 
-        if (major_minor == target_dev) {
-            exact_dev_match = format_output(source, fs_type);
+        std::string source = unescape_mountinfo(entry->source);
+        auto seen = std::ranges::find(mounts, source, &MountEntry::source);
+        if (seen != mounts.end()) {
+            if (mount_point.size() < seen->mount_point.size())
+                seen->mount_point = std::move(mount_point);
+            continue;
         }
 
-        if (path.starts_with(mount_point)) {  // C++20 starts_with
-            bool valid_boundary = (path.size() == mount_point.size()) || (mount_point == "/") ||
-                                  (path[mount_point.size()] == '/');
-
-            if (valid_boundary && mount_point.size() > best_path_len) {
-                best_path_len = mount_point.size();
-                best_path_match = format_output(source, fs_type);
-            }
+        MountEntry mount;
+        mount.mount_point = std::move(mount_point);
+        mount.source = std::move(source);
+        mount.fs_type = std::string(entry->fs_type);
+        mount.major_minor = std::string(entry->major_minor);
+        mount.disks = backing_disks(std::filesystem::path("/sys/dev/block") / mount.major_minor);
+        if (mount.disks.empty()) {
+            // btrfs reports an anonymous device number; go through the source node instead.
+            std::error_code ec;
+            auto node = std::filesystem::canonical(mount.source, ec);
+            if (!ec)
+                mount.disks = backing_disks(std::filesystem::path("/sys/class/block") /
+                                            node.filename());
         }
+        mounts.push_back(std::move(mount));
     }
 
-    if (best_path_len > 0 && best_path_match != "unknown device") {
-        return best_path_match;
-    }
-
-    if (!exact_dev_match.empty()) {
-        return exact_dev_match;
-    }
-
-    return best_path_match;
+    return mounts;
 }
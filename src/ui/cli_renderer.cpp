@@ -192,6 +192,722 @@ void render_speed_results(const SpeedTestResult& result) {
     }
 }
 
+namespace {
+
+std::string format_latency(double us) {
+    if (us >= 1'000'000.0) {
+        return std::format("{:.2f} s", us / 1'000'000.0);
+    }
+    if (us >= 1000.0) {
+        return std::format("{:.2f} ms", us / 1000.0);
+    }
+    return std::format("{:.0f} us", us);
+}
+
+void print_phase_header(std::string_view title, int label_width) {
+    std::println(" {:<{}}: {:>10}  {:>9}  {:>9}  {:>9}  {:>9}",
+                 title,
+                 label_width,
+                 "IOPS",
+                 "MB/s",
+                 "p50",
+                 "p99",
+                 "p99.9");
+}
+
+void print_phase_row(const DiskRandomPhaseResult& phase, int label_width) {
+    std::println(" {:<{}}: {}{:>10.0f}{}  {}{:>9.1f}{}  {}{:>9}  {:>9}  {:>9}{}",
+                 phase.label,
+                 label_width,
+                 Color::YELLOW,
+                 phase.iops,
+                 Color::RESET,
+                 Color::CYAN,
+                 phase.mbps,
+                 Color::RESET,
+                 Color::GREEN,
+                 format_latency(phase.latency.p50_us),
+                 format_latency(phase.latency.p99_us),
+                 format_latency(phase.latency.p999_us),
+                 Color::RESET);
+}
+
+// Condenses a throughput series into `width` glyphs, each the mean of its slice scaled
+// against the series peak.
+std::string make_sparkline(std::span<const double> series, std::size_t width) {
+    constexpr std::array<std::string_view, 8> blocks = {"\u2581",
+                                                        "\u2582",
+                                                        "\u2583",
+                                                        "\u2584",
+                                                        "\u2585",
+                                                        "\u2586",
+                                                        "\u2587",
+                                                        "\u2588"};
+    constexpr std::array<std::string_view, 8> ascii = {"_", ".", "-", "~", "=", "+", "*", "#"};
+    const auto& glyphs = (Config::UI_FORCE_ASCII || !is_utf8_term()) ? ascii : blocks;
+
+    if (series.empty() || width == 0)
+        return {};
+
+    width = std::min(width, series.size());
+    std::vector<double> columns(width);
+    for (std::size_t col = 0; col < width; ++col) {
+        const std::size_t first = col * series.size() / width;
+        const std::size_t last = (col + 1) * series.size() / width;
+        double sum = 0.0;
+        for (std::size_t i = first; i < last; ++i) {
+            sum += series[i];
+        }
+        columns[col] = sum / static_cast<double>(last - first);
+    }
+
+    const double peak = std::ranges::max(columns);
+    const auto top = static_cast<double>(glyphs.size() - 1);
+    std::string line;
+    for (double value : columns) {
+        const double scaled = peak > 0 ? std::clamp(value / peak, 0.0, 1.0) * top : 0.0;
+        line += glyphs[static_cast<std::size_t>(scaled + 0.5)];
+    }
+    return line;
+}
+
+}  // namespace
+
+void render_disk_random_results(const DiskRandomResult& result, int label_width) {
+    print_phase_header(
+        std::format(" QD{} x {}", result.queue_depth, format_bytes(result.block_size)),
+        label_width);
+    for (const auto& phase : result.phases) {
+        print_phase_row(phase, label_width);
+    }
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_noisy_neighbor_results(const DiskNoisyNeighborResult& result, int label_width) {
+    std::println(" {:<{}}: {}   {}",
+                 result.run.label,
+                 label_width,
+                 Color::colorize(std::format("Write {:>8.1f} MB/s", result.run.write_mbps),
+                                 Color::YELLOW),
+                 Color::colorize(std::format("Read {:>8.1f} MB/s", result.run.read_mbps),
+                                 Color::CYAN));
+    std::println(" {:<{}}: Write {:>+8.1f} %      Read {:>+8.1f} %",
+                 " vs Idle Avg",
+                 label_width,
+                 result.write_percent,
+                 result.read_percent);
+
+    if (!result.random)
+        return;
+    render_disk_random_results(*result.random, label_width);
+    if (result.random_changes.empty())
+        return;
+    std::println(" {:<{}}: {:>10}  {:>9}", " vs Idle", label_width, "IOPS", "p99");
+    for (const auto& change : result.random_changes) {
+        std::println(" {:<{}}: {:>+9.1f}%  {:>+8.1f}%",
+                     change.label,
+                     label_width,
+                     change.iops_percent,
+                     change.p99_percent);
+    }
+}
+
+void render_disk_metadata_results(const DiskMetadataResult& result, int label_width) {
+    std::println(" {:<{}}: {}", " Filesystem", label_width, result.filesystem);
+    std::println(" {:<{}}: {} files / {} dirs / {} threads",
+                 " Layout",
+                 label_width,
+                 result.files,
+                 result.directories,
+                 result.threads);
+    for (const auto& phase : result.phases) {
+        std::println(" {:<{}}: {}",
+                     " " + phase.op,
+                     label_width,
+                     Color::colorize(std::format("{:>10.0f} ops/s", phase.ops_per_sec),
+                                     Color::YELLOW));
+    }
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_cpu_results(const CpuBenchmarkResult& result, int label_width) {
+    const std::string multi_header = std::format("{}T Score", result.threads);
+    std::println(" {:<{}}: {:>8} {:>12}  {:>8} {:>12}  {:>7}",
+                 " CPU Benchmark",
+                 label_width,
+                 "1T Score",
+                 "Rate",
+                 multi_header,
+                 "Rate",
+                 "Scaling");
+
+    for (const auto& kernel : result.kernels) {
+        std::println(" {:<{}}: {}{:>8.0f}{} {:>12}  {}{:>8.0f}{} {:>12}  {:>6.0f}%",
+                     " " + kernel.name,
+                     label_width,
+                     Color::YELLOW,
+                     kernel.single_score,
+                     Color::RESET,
+                     std::format("{:.1f} {}", kernel.single_rate, kernel.unit),
+                     Color::CYAN,
+                     kernel.multi_score,
+                     Color::RESET,
+                     std::format("{:.1f} {}", kernel.multi_rate, kernel.unit),
+                     kernel.scaling_efficiency * 100.0);
+    }
+
+    std::println(" {:<{}}: {}{:>8.0f}{} {:>12}  {}{:>8.0f}{} {:>12}  {:>6.0f}%",
+                 " Overall (geomean)",
+                 label_width,
+                 Color::YELLOW,
+                 result.single_score,
+                 Color::RESET,
+                 "",
+                 Color::CYAN,
+                 result.multi_score,
+                 Color::RESET,
+                 "",
+                 result.scaling_efficiency * 100.0);
+}
+
+void render_memory_bandwidth_results(const MemoryBandwidthResult& result, int label_width) {
+    std::println(" {:<{}}: {} per array x 3, THP {}",
+                 " Working Set",
+                 label_width,
+                 format_bytes(result.array_bytes),
+                 result.thp_mode);
+
+    const std::string multi_header = std::format("{}T", result.threads);
+    std::println(" {:<{}}: {:>12}  {:>12}", " Memory Bandwidth", label_width, "1T", multi_header);
+    for (const auto& kernel : result.kernels) {
+        std::println(
+            " {:<{}}: {}   {}",
+            " " + kernel.name,
+            label_width,
+            Color::colorize(std::format("{:>7.2f} GB/s", kernel.single_gbps), Color::YELLOW),
+            Color::colorize(std::format("{:>7.2f} GB/s", kernel.multi_gbps), Color::CYAN));
+    }
+}
+
+void render_memory_latency_results(const MemoryLatencyResult& result, int label_width) {
+    std::println(" {:<{}}: {:>10} {:>10} {:>10}",
+                 std::format(" Latency (CPU {})", result.cpu),
+                 label_width,
+                 "2M pages",
+                 "4K pages",
+                 "TLB cost");
+    for (const auto& point : result.points) {
+        std::string knee;
+        for (const auto& level : result.levels) {
+            if (level.size_bytes == point.size_bytes && level.name != "DRAM")
+                knee = std::format("  <- {} edge", level.name);
+        }
+        std::println(" {:<{}}: {} {} {:>+7.2f} ns{}",
+                     " " + format_bytes(point.size_bytes),
+                     label_width,
+                     Color::colorize(std::format("{:>7.2f} ns", point.huge_page_ns), Color::YELLOW),
+                     Color::colorize(std::format("{:>7.2f} ns", point.small_page_ns), Color::CYAN),
+                     point.small_page_ns - point.huge_page_ns,
+                     Color::colorize(knee, Color::GREEN));
+    }
+
+    std::println(" {:<{}}: THP {}", " Detected Levels", label_width, result.thp_mode);
+    for (const auto& level : result.levels) {
+        std::string reported;
+        if (level.reported_bytes > 0)
+            reported = std::format(" (sysfs {})", format_bytes(level.reported_bytes));
+        if (level.name == "DRAM") {
+            std::println(" {:<{}}: {:>7.2f} ns beyond the last cache",
+                         " " + level.name,
+                         label_width,
+                         level.latency_ns);
+        } else {
+            std::println(" {:<{}}: {:>7.2f} ns up to {}{}",
+                         " " + level.name,
+                         label_width,
+                         level.latency_ns,
+                         format_bytes(level.size_bytes),
+                         reported);
+        }
+    }
+}
+
+void render_disk_small_file_results(const DiskSmallFileResult& result, int label_width) {
+    std::println(" {:<{}}: {}", " Filesystem", label_width, result.filesystem);
+    std::println(" {:<{}}: {} files, {} total, {} threads",
+                 " Layout",
+                 label_width,
+                 result.files,
+                 format_bytes(result.total_bytes),
+                 result.threads);
+    for (const auto& phase : result.phases) {
+        std::println(
+            " {:<{}}: {}   {}",
+            " Small Files " + phase.op,
+            label_width,
+            Color::colorize(std::format("{:>9.0f} files/s", phase.files_per_sec), Color::YELLOW),
+            Color::colorize(std::format("{:>8.1f} MB/s", phase.mbps), Color::CYAN));
+    }
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_disk_raw_device_results(const DiskRawDeviceResult& result, int label_width) {
+    std::println(" {:<{}}: {} ({}, {}B logical blocks, max request {})",
+                 " Device",
+                 label_width,
+                 result.device,
+                 format_bytes(result.size),
+                 result.logical_block_size,
+                 result.max_io_bytes > 0 ? format_bytes(result.max_io_bytes) : "unknown");
+    print_phase_header(" Read-only", label_width);
+    for (const auto& phase : result.phases) {
+        print_phase_row(phase, label_width);
+    }
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_disk_multi_job_results(const DiskMultiJobResult& result, int label_width) {
+    auto row = [&](std::string_view label, double write_mbps, double read_mbps) {
+        std::println(" {:<{}}: {}   {}",
+                     label,
+                     label_width,
+                     Color::colorize(std::format("Write {:>8.1f} MB/s", write_mbps), Color::YELLOW),
+                     Color::colorize(std::format("Read {:>8.1f} MB/s", read_mbps), Color::CYAN));
+    };
+
+    for (std::size_t i = 0; i < result.jobs.size(); ++i) {
+        const auto& job = result.jobs[i];
+        row(std::format(" Job #{} (CPU {})", i + 1, job.cpu), job.write_mbps, job.read_mbps);
+    }
+    row(std::format(" Aggregate ({} jobs)", result.jobs.size()),
+        result.aggregate_write_mbps,
+        result.aggregate_read_mbps);
+
+    std::println(" {:<{}}: Write {:>8.3f}        Read {:>8.3f}",
+                 " Fairness (Jain)",
+                 label_width,
+                 result.write_fairness,
+                 result.read_fairness);
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_disk_steady_state_results(const DiskSteadyStateResult& result, int label_width) {
+    const std::size_t spark_width =
+        Config::TERM_WIDTH - static_cast<std::size_t>(label_width) - 6;
+
+    for (const auto& phase : result.phases) {
+        std::println(" {:<{}}: {}{}{}",
+                     phase.label,
+                     label_width,
+                     Color::CYAN,
+                     make_sparkline(phase.series_mbps, spark_width),
+                     Color::RESET);
+
+        std::println(" {:<{}}  burst {:.1f} MB/s, sustained {:.1f} MB/s, mean {:.1f} MB/s",
+                     "",
+                     label_width,
+                     phase.burst_mbps,
+                     phase.steady_mbps,
+                     phase.mean_mbps);
+
+        std::string verdict;
+        if (phase.cliff_seconds < 0) {
+            verdict = Color::colorize("no throughput cliff detected", Color::GREEN);
+        } else {
+            const double retained =
+                phase.burst_mbps > 0 ? phase.steady_mbps / phase.burst_mbps * 100.0 : 0.0;
+            verdict = Color::colorize(
+                std::format("cliff after {:.1f} s, sustained at {:.0f}% of burst",
+                            phase.cliff_seconds,
+                            retained),
+                Color::RED);
+        }
+        std::println(" {:<{}}  {}", "", label_width, verdict);
+    }
+
+    std::println(" {:<{}}: {} over {}, {} ms samples",
+                 " Window",
+                 label_width,
+                 std::format("{} s", result.duration_seconds),
+                 format_bytes(result.file_size),
+                 Config::IO_STEADY_SAMPLE_MS);
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_disk_engine_results(const DiskEngineComparisonResult& result, int label_width) {
+    const DiskEngineResult* direct = nullptr;
+    for (const auto& entry : result.engines) {
+        if (entry.engine == "uring-direct")
+            direct = &entry;
+    }
+
+    auto delta = [](double value, double baseline) {
+        if (baseline <= 0)
+            return std::string("-");
+        return std::format("{:+.1f}%", (value - baseline) / baseline * 100.0);
+    };
+
+    std::println(" {:<{}}: {:>10}  {:>10}  {:>9}  {:>9}",
+                 " Engine",
+                 label_width,
+                 "Write MB/s",
+                 "Read MB/s",
+                 "W vs raw",
+                 "R vs raw");
+    for (const auto& entry : result.engines) {
+        std::println(" {:<{}}: {}{:>10.1f}{}  {}{:>10.1f}{}  {:>9}  {:>9}",
+                     " " + entry.engine,
+                     label_width,
+                     Color::YELLOW,
+                     entry.write_mbps,
+                     Color::RESET,
+                     Color::CYAN,
+                     entry.read_mbps,
+                     Color::RESET,
+                     direct ? delta(entry.write_mbps, direct->write_mbps) : "-",
+                     direct ? delta(entry.read_mbps, direct->read_mbps) : "-");
+    }
+    for (const auto& entry : result.engines) {
+        std::println(" {:<{}}: {}", " " + entry.engine + " path", label_width, entry.io_path);
+    }
+}
+
+void render_disk_multi_path_results(const DiskMultiPathResult& result, int label_width) {
+    std::println(" {:<{}}: {:<16}  {:>10}  {:>10}  {}",
+                 " Mount",
+                 label_width,
+                 "Device",
+                 "Write MB/s",
+                 "Read MB/s",
+                 "Mode");
+    for (const auto& path : result.paths) {
+        std::string device = path.disks.empty() ? path.source : path.disks;
+        if (device.size() > 16)
+            device = device.substr(0, 15) + "~";
+
+        if (!path.error.empty()) {
+            std::string error = path.error;
+            if (error.size() > Config::MAX_ERROR_DISPLAY_LEN)
+                error = error.substr(0, Config::MAX_ERROR_DISPLAY_LEN - 3) + "...";
+            std::println(" {:<{}}: {:<16}  {}",
+                         " " + path.mount_point,
+                         label_width,
+                         device,
+                         Color::colorize(error, Color::RED));
+            continue;
+        }
+
+        const auto sharing = std::ranges::count(result.paths, path.group, &DiskPathResult::group);
+        std::println(" {:<{}}: {:<16}  {}{:>10.1f}{}  {}{:>10.1f}{}  {}",
+                     " " + path.mount_point,
+                     label_width,
+                     device,
+                     Color::YELLOW,
+                     path.write_mbps,
+                     Color::RESET,
+                     Color::CYAN,
+                     path.read_mbps,
+                     Color::RESET,
+                     sharing > 1 ? "sequential (shared disk)"
+                                 : (result.groups > 1 ? "parallel" : "alone"));
+    }
+}
+
+void render_disk_cold_read_results(const DiskColdReadResult& result, int label_width) {
+    auto row = [&](std::string_view label, double mbps, const LatencyStats& lat) {
+        std::println(" {:<{}}: {}   {}",
+                     label,
+                     label_width,
+                     Color::colorize(std::format("Read {:>8.1f} MB/s", mbps), Color::CYAN),
+                     Color::colorize(std::format("p50 {:>9}  p99 {:>9}",
+                                                 format_latency(lat.p50_us),
+                                                 format_latency(lat.p99_us)),
+                                     Color::GREEN));
+    };
+
+    row(" Cold Read", result.cold_mbps, result.cold_latency);
+    row(" Warm Read", result.warm_mbps, result.warm_latency);
+
+    if (result.cold_mbps > 0) {
+        const double gain = (result.warm_mbps - result.cold_mbps) / result.cold_mbps * 100.0;
+        std::println(" {:<{}}: {:+.1f}%{}",
+                     " Warm vs Cold",
+                     label_width,
+                     gain,
+                     gain > 20.0 ? "  (a cache below the guest is serving re-reads)" : "");
+    }
+
+    const double multiple = result.ram_total > 0 ? static_cast<double>(result.working_set) /
+                                                       static_cast<double>(result.ram_total)
+                                                 : 0.0;
+    std::println(" {:<{}}: {} ({:.1f}x RAM), {} regions x {} read",
+                 " Working Set",
+                 label_width,
+                 format_bytes(result.working_set),
+                 multiple,
+                 result.regions,
+                 format_bytes(result.bytes_read / std::max<std::size_t>(1, result.regions)));
+    if (result.space_limited) {
+        // Below RAM, a host cache no larger than the guest can hold the whole file, so the
+        // cold numbers may say nothing about the disk.
+        const std::string_view note =
+            result.working_set < result.ram_total
+                ? "capped by free space below RAM; cold reads may be served from cache"
+                : "capped by free space; caches larger than this survive";
+        std::println(" {:<{}}: {}", "", label_width, Color::colorize(note, Color::YELLOW));
+    }
+    std::println(" {:<{}}: {}", " I/O Path", label_width, result.io_path);
+}
+
+void render_disk_commit_results(const DiskCommitResult& result, int label_width) {
+    std::println(" {:<{}}: {:>10}  {:>9}  {:>9}  {:>9}  {:>9}",
+                 " Record Size",
+                 label_width,
+                 "fsyncs/s",
+                 "p50",
+                 "p99",
+                 "p99.9",
+                 "max");
+
+    std::string_view current_method;
+    for (const auto& phase : result.phases) {
+        if (phase.method != current_method) {
+            current_method = phase.method;
+            std::println(" {}", Color::colorize(current_method, Color::BOLD));
+        }
+        std::println(" {:<{}}: {}{:>10.0f}{}  {}{:>9}  {:>9}  {:>9}  {:>9}{}",
+                     "  " + format_bytes(phase.record_size),
+                     label_width,
+                     Color::YELLOW,
+                     phase.commits_per_sec,
+                     Color::RESET,
+                     Color::GREEN,
+                     format_latency(phase.latency.p50_us),
+                     format_latency(phase.latency.p99_us),
+                     format_latency(phase.latency.p999_us),
+                     format_latency(phase.latency.max_us),
+                     Color::RESET);
+    }
+}
+
+void render_latency_table(std::span<const std::pair<std::string, LatencyStats>> rows) {
+    constexpr int label_width = Config::IO_LABEL_WIDTH;
+    std::println(" {:<{}}: {:>7} {:>7} {:>7} {:>7} {:>7} {:>7} {:>7}",
+                 " Latency",
+                 label_width,
+                 "min",
+                 "mean",
+                 "p50",
+                 "p90",
+                 "p99",
+                 "p99.9",
+                 "max");
+
+    for (const auto& [label, lat] : rows) {
+        std::println(" {:<{}}: {}{:>7} {:>7} {:>7} {:>7} {}{:>7} {:>7} {:>7}{}",
+                     label,
+                     label_width,
+                     Color::GREEN,
+                     format_latency(lat.min_us),
+                     format_latency(lat.mean_us),
+                     format_latency(lat.p50_us),
+                     format_latency(lat.p90_us),
+                     Color::YELLOW,
+                     format_latency(lat.p99_us),
+                     format_latency(lat.p999_us),
+                     format_latency(lat.max_us),
+                     Color::RESET);
+    }
+}
+
+void render_kernel_io_table(std::span<const std::pair<std::string, DiskKernelStats>> rows) {
+    if (rows.empty())
+        return;
+
+    constexpr int label_width = Config::IO_LABEL_WIDTH;
+    std::println(" {:<{}}: {:>8} {:>8} {:>8} {:>7} {:>6} {:>6}",
+                 std::format(" Kernel ({})", rows.front().second.device),
+                 label_width,
+                 "IOPS",
+                 "req KiB",
+                 "sub KiB",
+                 "merge%",
+                 "queue",
+                 "util%");
+
+    for (const auto& [label, k] : rows) {
+        // 10% slack absorbs the short final request of a pass.
+        std::string_view note;
+        if (k.request_kib > 0 && k.request_kib < k.submitted_kib * 0.9)
+            note = "  split";
+        else if (k.request_kib > k.submitted_kib * 1.1 || k.merge_percent > 1.0)
+            note = "  coalesced";
+
+        std::println(" {:<{}}: {}{:>8.0f} {:>8.1f} {:>8.1f} {:>7.1f} {:>6.1f} {:>6.1f}{}{}{}",
+                     label,
+                     label_width,
+                     Color::GREEN,
+                     k.iops,
+                     k.request_kib,
+                     k.submitted_kib,
+                     k.merge_percent,
+                     k.avg_queue,
+                     k.util_percent,
+                     Color::YELLOW,
+                     note,
+                     Color::RESET);
+    }
+}
+
+void render_steal_table(std::span<const std::pair<std::string, CpuStealStats>> rows) {
+    if (rows.empty())
+        return;
+
+    constexpr int label_width = Config::IO_LABEL_WIDTH;
+    std::println(" {:<{}}: {:>8} {:>8}", " CPU Steal by Phase", label_width, "steal%", "iowait%");
+    for (const auto& [label, s] : rows) {
+        const auto color =
+            s.steal_percent >= Config::CPU_STEAL_WARN_PERCENT ? Color::RED : Color::GREEN;
+        std::println(" {:<{}}: {}{:>8.2f}{} {:>8.2f}",
+                     label,
+                     label_width,
+                     color,
+                     s.steal_percent,
+                     Color::RESET,
+                     s.iowait_percent);
+    }
+}
+
+void render_cpu_jitter_results(const CpuJitterResult& result, int label_width) {
+    std::println(" {:<{}}: {:>8} {:>9} {:>7} {:>7}",
+                 std::format(" Jitter ({}s)", result.duration_seconds),
+                 label_width,
+                 "gaps",
+                 "max gap",
+                 "lost%",
+                 "steal%");
+    for (const auto& core : result.cores) {
+        const auto color =
+            core.steal_percent >= Config::CPU_STEAL_WARN_PERCENT ? Color::RED : Color::GREEN;
+        std::println(" {:<{}}: {:>8} {}{:>9}{} {:>7.3f} {}{:>7.2f}{}",
+                     std::format(" CPU {}", core.cpu),
+                     label_width,
+                     core.gaps,
+                     Color::YELLOW,
+                     format_latency(core.max_gap_us),
+                     Color::RESET,
+                     core.lost_percent,
+                     color,
+                     core.steal_percent,
+                     Color::RESET);
+    }
+
+    std::string header;
+    for (double edge : result.bucket_edges_us) {
+        header += edge >= 1000.0 ? std::format(" {:>7}", std::format(">={:.0f}ms", edge / 1000.0))
+                                 : std::format(" {:>7}", std::format(">={:.0f}us", edge));
+    }
+    std::println(" {:<{}}:{}", " Gap Histogram", label_width, header);
+    for (const auto& core : result.cores) {
+        std::string counts;
+        for (auto count : core.histogram)
+            counts += std::format(" {:>7}", count);
+        std::println(" {:<{}}:{}", std::format(" CPU {}", core.cpu), label_width, counts);
+    }
+}
+
+void render_core_latency_results(const CpuCoreLatencyResult& result, int label_width) {
+    std::println(" {}", Color::colorize("Round Trip (ns, cache-line ping-pong)", Color::BOLD));
+
+    std::vector<std::size_t> domain_of(result.cpus.size(), 0);
+    for (std::size_t d = 0; d < result.domains.size(); ++d) {
+        for (int cpu : result.domains[d].cpus) {
+            auto it = std::ranges::find(result.cpus, cpu);
+            domain_of[static_cast<std::size_t>(it - result.cpus.begin())] = d;
+        }
+    }
+
+    std::string header = std::format(" {:<6} ", "CPU");
+    for (int cpu : result.cpus)
+        header += std::format("{:>5} ", cpu);
+    std::println("{}", header);
+
+    for (std::size_t i = 0; i < result.cpus.size(); ++i) {
+        std::string line;
+        for (std::size_t j = 0; j < result.cpus.size(); ++j) {
+            if (i == j) {
+                line += std::format("{:>5} ", "-");
+                continue;
+            }
+            const auto color = domain_of[i] == domain_of[j] ? Color::GREEN : Color::YELLOW;
+            line += Color::colorize(std::format("{:>5.0f} ", result.round_trip_ns[i][j]), color);
+        }
+        std::println(" {}{:<6}{} {}", Color::CYAN, result.cpus[i], Color::RESET, line);
+    }
+
+    std::println(" {:<{}}: {} (split above {:.0f} ns)",
+                 " Latency Domains",
+                 label_width,
+                 result.domains.size(),
+                 result.domain_threshold_ns);
+    for (std::size_t d = 0; d < result.domains.size(); ++d) {
+        const auto& domain = result.domains[d];
+        std::string cpus;
+        for (int cpu : domain.cpus)
+            cpus += std::format("{}{}", cpus.empty() ? "" : ",", cpu);
+        std::println(" {:<{}}: CPUs {} ({:.0f} ns inside)",
+                     std::format(" Domain {}", d + 1),
+                     label_width,
+                     cpus,
+                     domain.mean_round_trip_ns);
+    }
+    if (result.domains.size() > 1) {
+        std::println(" {:<{}}: {:.0f} ns", " Across Domains", label_width, result.inter_domain_ns);
+    }
+}
+
+void render_disk_sweep_results(const DiskSweepResult& result) {
+    const std::size_t columns = result.queue_depths.size();
+
+    auto render_matrix = [&](std::string_view title, auto&& cell_text) {
+        std::println(" {}", Color::colorize(title, Color::BOLD));
+
+        std::string header = std::format(" {:<6} ", "BS\\QD");
+        for (int qd : result.queue_depths) {
+            header += std::format("{:>7} ", std::format("QD{}", qd));
+        }
+        std::println("{}", header);
+
+        for (std::size_t row = 0; row < result.block_sizes.size(); ++row) {
+            std::string line;
+            for (std::size_t col = 0; col < columns; ++col) {
+                const auto& cell = result.cells[row * columns + col];
+                line += std::format("{:>7} ", cell.skipped ? "-" : cell_text(cell));
+            }
+            std::println(" {}{:<6}{} {}{}{}",
+                         Color::YELLOW,
+                         format_bytes(result.block_sizes[row]),
+                         Color::RESET,
+                         Color::CYAN,
+                         line,
+                         Color::RESET);
+        }
+    };
+
+    render_matrix("Throughput (MB/s, random read)", [](const DiskSweepCell& cell) {
+        return std::format("{:.1f}", cell.mbps);
+    });
+    std::println("");
+    render_matrix("p99 Completion Latency",
+                  [](const DiskSweepCell& cell) { return format_latency(cell.latency.p99_us); });
+    if (std::ranges::any_of(result.cells, &DiskSweepCell::skipped)) {
+        std::println(" '-': QD x block exceeds the {} buffer pool ({}% of available memory)",
+                     format_bytes(result.pool_bytes),
+                     Config::IO_SWEEP_MAX_MEMORY_PERCENT);
+    }
+    std::println(" I/O Path: {}", result.io_path);
+}
+
 SpinnerCallback make_spinner_callback() {
     auto spinner = std::make_shared<UiSpinner>();
     return [spinner](SpinnerEvent ev, std::string_view label) {
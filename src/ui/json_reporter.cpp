@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2025 Alfie Ardinata
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "include/json_reporter.hpp"
+
+#include <cerrno>
+#include <format>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "include/utils.hpp"
+
+using json = nlohmann::json;
+
+void to_json(json& j, const LatencyStats& stats) {
+    j = json{{"samples", stats.samples},
+             {"min_us", stats.min_us},
+             {"mean_us", stats.mean_us},
+             {"p50_us", stats.p50_us},
+             {"p90_us", stats.p90_us},
+             {"p99_us", stats.p99_us},
+             {"p999_us", stats.p999_us},
+             {"max_us", stats.max_us}};
+}
+
+void to_json(json& j, const DiskKernelStats& stats) {
+    j = json{{"device", stats.device},
+             {"iops", stats.iops},
+             {"merge_percent", stats.merge_percent},
+             {"request_kib", stats.request_kib},
+             {"submitted_kib", stats.submitted_kib},
+             {"avg_queue", stats.avg_queue},
+             {"util_percent", stats.util_percent}};
+}
+
+void to_json(json& j, const DiskIORunResult& result) {
+    j = json{{"label", trim(result.label)},
+             {"write_mbps", result.write_mbps},
+             {"read_mbps", result.read_mbps},
+             {"write_latency", result.write_latency},
+             {"read_latency", result.read_latency},
+             {"verified", result.verified},
+             {"converged", result.converged},
+             {"bytes_written", result.bytes_written},
+             {"io_path", result.io_path}};
+    if (result.verified)
+        j["verify_read_mbps"] = result.verify_read_mbps;
+    if (result.write_ci_mbps)
+        j["write_ci_mbps"] = *result.write_ci_mbps;
+    if (result.read_ci_mbps)
+        j["read_ci_mbps"] = *result.read_ci_mbps;
+    if (result.write_kernel)
+        j["write_kernel"] = *result.write_kernel;
+    if (result.read_kernel)
+        j["read_kernel"] = *result.read_kernel;
+}
+
+void to_json(json& j, const DiskRandomPhaseResult& phase) {
+    j = json{{"label", trim(phase.label)},
+             {"iops", phase.iops},
+             {"mbps", phase.mbps},
+             {"latency", phase.latency}};
+}
+
+void to_json(json& j, const DiskRandomResult& result) {
+    j = json{{"phases", result.phases},
+             {"queue_depth", result.queue_depth},
+             {"block_size", result.block_size},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskNoisyPhaseChange& change) {
+    j = json{{"label", trim(change.label)},
+             {"iops_percent", change.iops_percent},
+             {"p99_percent", change.p99_percent}};
+}
+
+void to_json(json& j, const DiskNoisyNeighborResult& result) {
+    j = json{{"load", result.load},
+             {"workers", result.workers},
+             {"run", result.run},
+             {"write_percent", result.write_percent},
+             {"read_percent", result.read_percent},
+             {"random_changes", result.random_changes}};
+    if (result.random)
+        j["random"] = *result.random;
+}
+
+void to_json(json& j, const DiskRawDeviceResult& result) {
+    j = json{{"device", result.device},
+             {"size", result.size},
+             {"logical_block_size", result.logical_block_size},
+             {"max_io_bytes", result.max_io_bytes},
+             {"phases", result.phases},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskSweepCell& cell) {
+    j = json{{"queue_depth", cell.queue_depth},
+             {"block_size", cell.block_size},
+             {"skipped", cell.skipped}};
+    if (!cell.skipped) {
+        j["iops"] = cell.iops;
+        j["mbps"] = cell.mbps;
+        j["latency"] = cell.latency;
+    }
+}
+
+void to_json(json& j, const DiskSweepResult& result) {
+    j = json{{"queue_depths", result.queue_depths},
+             {"block_sizes", result.block_sizes},
+             {"cells", result.cells},
+             {"pool_bytes", result.pool_bytes},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskJobResult& job) {
+    j = json{{"cpu", job.cpu}, {"write_mbps", job.write_mbps}, {"read_mbps", job.read_mbps}};
+}
+
+void to_json(json& j, const DiskMultiJobResult& result) {
+    j = json{{"jobs", result.jobs},
+             {"aggregate_write_mbps", result.aggregate_write_mbps},
+             {"aggregate_read_mbps", result.aggregate_read_mbps},
+             {"write_fairness", result.write_fairness},
+             {"read_fairness", result.read_fairness},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskSteadyStatePhaseResult& phase) {
+    j = json{{"label", trim(phase.label)},
+             {"series_mbps", phase.series_mbps},
+             {"sample_interval_ms", phase.sample_interval_ms},
+             {"mean_mbps", phase.mean_mbps},
+             {"burst_mbps", phase.burst_mbps},
+             {"steady_mbps", phase.steady_mbps},
+             {"cliff_seconds", nullptr}};
+    if (phase.cliff_seconds >= 0)
+        j["cliff_seconds"] = phase.cliff_seconds;
+}
+
+void to_json(json& j, const DiskSteadyStateResult& result) {
+    j = json{{"phases", result.phases},
+             {"file_size", result.file_size},
+             {"duration_seconds", result.duration_seconds},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskEngineResult& engine) {
+    j = json{{"engine", engine.engine},
+             {"write_mbps", engine.write_mbps},
+             {"read_mbps", engine.read_mbps},
+             {"io_path", engine.io_path}};
+}
+
+void to_json(json& j, const DiskEngineComparisonResult& result) {
+    j = json{{"engines", result.engines}, {"file_size", result.file_size}};
+}
+
+void to_json(json& j, const DiskCommitPhaseResult& phase) {
+    j = json{{"method", phase.method},
+             {"record_size", phase.record_size},
+             {"commits_per_sec", phase.commits_per_sec},
+             {"latency", phase.latency}};
+}
+
+void to_json(json& j, const DiskCommitResult& result) {
+    j = json{{"phases", result.phases}};
+}
+
+void to_json(json& j, const DiskColdReadResult& result) {
+    j = json{{"working_set", result.working_set},
+             {"ram_total", result.ram_total},
+             {"bytes_read", result.bytes_read},
+             {"regions", result.regions},
+             {"cold_mbps", result.cold_mbps},
+             {"warm_mbps", result.warm_mbps},
+             {"cold_latency", result.cold_latency},
+             {"warm_latency", result.warm_latency},
+             {"space_limited", result.space_limited},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskPathResult& path) {
+    j = json{{"mount_point", path.mount_point},
+             {"source", path.source},
+             {"fs_type", path.fs_type},
+             {"disks", path.disks},
+             {"group", path.group}};
+    if (path.error.empty()) {
+        j["write_mbps"] = path.write_mbps;
+        j["read_mbps"] = path.read_mbps;
+        j["io_path"] = path.io_path;
+    } else {
+        j["error"] = path.error;
+    }
+}
+
+void to_json(json& j, const DiskMultiPathResult& result) {
+    j = json{{"paths", result.paths}, {"file_size", result.file_size}, {"groups", result.groups}};
+}
+
+void to_json(json& j, const DiskMetadataPhaseResult& phase) {
+    j = json{{"op", phase.op}, {"ops", phase.ops}, {"ops_per_sec", phase.ops_per_sec}};
+}
+
+void to_json(json& j, const DiskMetadataResult& result) {
+    j = json{{"phases", result.phases},
+             {"files", result.files},
+             {"directories", result.directories},
+             {"threads", result.threads},
+             {"filesystem", result.filesystem},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const DiskSmallFilePhaseResult& phase) {
+    j = json{{"op", phase.op}, {"files_per_sec", phase.files_per_sec}, {"mbps", phase.mbps}};
+}
+
+void to_json(json& j, const DiskSmallFileResult& result) {
+    j = json{{"phases", result.phases},
+             {"files", result.files},
+             {"total_bytes", result.total_bytes},
+             {"threads", result.threads},
+             {"filesystem", result.filesystem},
+             {"io_path", result.io_path}};
+}
+
+void to_json(json& j, const CpuKernelResult& kernel) {
+    j = json{{"name", kernel.name},
+             {"unit", kernel.unit},
+             {"single_rate", kernel.single_rate},
+             {"multi_rate", kernel.multi_rate},
+             {"single_score", kernel.single_score},
+             {"multi_score", kernel.multi_score},
+             {"scaling_efficiency", kernel.scaling_efficiency}};
+}
+
+void to_json(json& j, const CpuBenchmarkResult& result) {
+    j = json{{"kernels", result.kernels},
+             {"threads", result.threads},
+             {"single_score", result.single_score},
+             {"multi_score", result.multi_score},
+             {"scaling_efficiency", result.scaling_efficiency}};
+}
+
+void to_json(json& j, const CpuStealStats& stats) {
+    j = json{{"steal_percent", stats.steal_percent}, {"iowait_percent", stats.iowait_percent}};
+}
+
+void to_json(json& j, const CpuJitterCoreResult& core) {
+    j = json{{"cpu", core.cpu},
+             {"gaps", core.gaps},
+             {"max_gap_us", core.max_gap_us},
+             {"lost_percent", core.lost_percent},
+             {"steal_percent", core.steal_percent},
+             {"histogram", core.histogram}};
+}
+
+void to_json(json& j, const CpuJitterResult& result) {
+    j = json{{"cores", result.cores},
+             {"bucket_edges_us", result.bucket_edges_us},
+             {"duration_seconds", result.duration_seconds}};
+}
+
+void to_json(json& j, const CpuLatencyDomain& domain) {
+    j = json{{"cpus", domain.cpus}, {"mean_round_trip_ns", domain.mean_round_trip_ns}};
+}
+
+void to_json(json& j, const CpuCoreLatencyResult& result) {
+    j = json{{"cpus", result.cpus},
+             {"round_trip_ns", result.round_trip_ns},
+             {"domains", result.domains},
+             {"domain_threshold_ns", result.domain_threshold_ns},
+             {"inter_domain_ns", result.inter_domain_ns}};
+}
+
+void to_json(json& j, const MemoryBandwidthKernelResult& kernel) {
+    j = json{{"name", kernel.name},
+             {"single_gbps", kernel.single_gbps},
+             {"multi_gbps", kernel.multi_gbps}};
+}
+
+void to_json(json& j, const MemoryBandwidthResult& result) {
+    j = json{{"kernels", result.kernels},
+             {"array_bytes", result.array_bytes},
+             {"threads", result.threads},
+             {"thp_mode", result.thp_mode}};
+}
+
+void to_json(json& j, const MemoryLatencyPoint& point) {
+    j = json{{"size_bytes", point.size_bytes},
+             {"huge_page_ns", point.huge_page_ns},
+             {"small_page_ns", point.small_page_ns}};
+}
+
+void to_json(json& j, const MemoryLatencyLevel& level) {
+    j = json{{"name", level.name},
+             {"size_bytes", level.size_bytes},
+             {"latency_ns", level.latency_ns},
+             {"reported_bytes", level.reported_bytes}};
+}
+
+void to_json(json& j, const MemoryLatencyResult& result) {
+    j = json{{"points", result.points},
+             {"levels", result.levels},
+             {"cpu", result.cpu},
+             {"thp_mode", result.thp_mode}};
+}
+
+void to_json(json& j, const SpeedEntryResult& entry) {
+    j = json{{"server_id", entry.server_id},
+             {"node_name", entry.node_name},
+             {"success", entry.success},
+             {"rate_limited", entry.rate_limited}};
+    if (entry.success) {
+        j["upload_mbps"] = entry.upload_mbps;
+        j["download_mbps"] = entry.download_mbps;
+        j["latency_ms"] = entry.latency_ms;
+        j["loss"] = entry.loss;
+    } else {
+        j["error"] = entry.error;
+    }
+}
+
+void to_json(json& j, const SwapEntry& swap) {
+    j = json{{"type", swap.type},
+             {"path", swap.path},
+             {"size", swap.size},
+             {"used", swap.used},
+             {"is_zswap", swap.is_zswap}};
+}
+
+void to_json(json& j, const MemInfo& mem) {
+    j = json{{"total", mem.total}, {"used", mem.used}, {"available", mem.available}};
+}
+
+void to_json(json& j, const DiskInfo& disk) {
+    j = json{{"total", disk.total},
+             {"used", disk.used},
+             {"free", disk.free},
+             {"available", disk.available}};
+}
+
+namespace {
+
+std::string make_run_id() {
+    std::random_device rd;
+    std::uint64_t id = (std::uint64_t{rd()} << 32) | rd();
+    return std::format("{:016x}", id);
+}
+
+}  // namespace
+
+JsonReporter::JsonReporter(FileDescriptor fd) : fd_(std::move(fd)), run_id_(make_run_id()) {}
+
+std::expected<JsonReporter, std::string> JsonReporter::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return std::unexpected(std::format(
+            "Cannot open '{}' for JSON output: {}", path, std::system_category().message(errno)));
+    }
+    return JsonReporter(FileDescriptor(fd));
+}
+
+JsonReporter JsonReporter::adopt(FileDescriptor fd) {
+    return JsonReporter(std::move(fd));
+}
+
+void JsonReporter::emit(std::string_view type, const json& data) {
+    json record = {{"run", run_id_}, {"seq", seq_++}, {"type", type}, {"data", data}};
+    // Replace rather than throw on invalid UTF-8 from sysfs or a speedtest node name.
+    std::string line = record.dump(-1, ' ', false, json::error_handler_t::replace);
+    line.push_back('\n');
+
+    std::string_view rest = line;
+    while (!rest.empty()) {
+        ssize_t n = ::write(fd_.get(), rest.data(), rest.size());
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return;  // A full disk or a gone reader (EPIPE, SIGPIPE is ignored) must not abort.
+        }
+        rest.remove_prefix(static_cast<std::size_t>(n));
+    }
+}
+
+void JsonReporter::emit_error(std::string_view benchmark, std::string_view message) {
+    emit("error", {{"benchmark", benchmark}, {"message", message}});
+}